@@ -21,6 +21,9 @@ CXX ?= g++
 # USE_OPENGL3=true
 # USE_NANOVG_FBO=true
 # USE_NANOVG_FREETYPE=true
+# USE_PARTIAL_REDRAW=true
+# USE_DISPLAY_TIMING=true
+# USE_HEADLESS=true
 # STATIC_BUILD=true
 # FORCE_NATIVE_AUDIO_FALLBACK=true
 # SKIP_NATIVE_AUDIO_FALLBACK=true
@@ -356,6 +359,7 @@ ifeq ($(HAIKU_OR_MACOS_OR_WASM_OR_WINDOWS),true)
 HAVE_OPENGL = true
 else
 HAVE_OPENGL  = $(shell $(PKG_CONFIG) --exists gl && echo true)
+HAVE_EGL     = $(shell $(PKG_CONFIG) --exists egl && echo true)
 HAVE_DBUS    = $(shell $(PKG_CONFIG) --exists dbus-1 && echo true)
 HAVE_X11     = $(shell $(PKG_CONFIG) --exists x11 && echo true)
 HAVE_XCURSOR = $(shell $(PKG_CONFIG) --exists xcursor && echo true)
@@ -426,6 +430,11 @@ DGL_SYSTEM_LIBS += -lcomdlg32
 DGL_SYSTEM_LIBS += -lgdi32
 # DGL_SYSTEM_LIBS += -lole32
 
+else ifeq ($(USE_HEADLESS),true)
+
+# render into offscreen surfaces, without any window system, see dgl/src/pugl-extra/headless.c
+DGL_FLAGS       += -DDGL_HEADLESS
+
 else
 
 ifeq ($(HAVE_DBUS),true)
@@ -475,6 +484,9 @@ endif
 endif
 else ifeq ($(WINDOWS),true)
 OPENGL_LIBS  = -lopengl32
+else ifeq ($(USE_HEADLESS),true)
+OPENGL_FLAGS = $(shell $(PKG_CONFIG) --cflags egl gl)
+OPENGL_LIBS  = $(shell $(PKG_CONFIG) --libs egl gl)
 else
 OPENGL_FLAGS = $(shell $(PKG_CONFIG) --cflags gl x11)
 OPENGL_LIBS  = $(shell $(PKG_CONFIG) --libs gl x11)
@@ -487,6 +499,8 @@ endif # HAVE_OPENGL
 
 ifeq ($(HAIKU_OR_MACOS_OR_WASM_OR_WINDOWS),true)
 HAVE_STUB = true
+else ifeq ($(USE_HEADLESS),true)
+HAVE_STUB = true
 else
 HAVE_STUB = $(HAVE_X11)
 endif
@@ -547,8 +561,12 @@ endif
 ifeq ($(HAIKU_OR_MACOS_OR_WASM_OR_WINDOWS),true)
 HAVE_DGL = true
 else ifeq ($(HAVE_OPENGL),true)
+ifeq ($(USE_HEADLESS),true)
+HAVE_DGL = $(HAVE_EGL)
+else
 HAVE_DGL = $(HAVE_X11)
 endif
+endif
 
 # ---------------------------------------------------------------------------------------------------------------------
 # Optional flags
@@ -589,6 +607,14 @@ ifeq ($(USE_NANOVG_FREETYPE),true)
 BUILD_CXX_FLAGS += -DFONS_USE_FREETYPE $(shell $(PKG_CONFIG) --cflags freetype2)
 endif
 
+ifeq ($(USE_PARTIAL_REDRAW),true)
+BUILD_CXX_FLAGS += -DDGL_USE_PARTIAL_REDRAW
+endif
+
+ifeq ($(USE_DISPLAY_TIMING),true)
+BUILD_CXX_FLAGS += -DDGL_DISPLAY_TIMING
+endif
+
 ifeq ($(USE_RGBA),true)
 BUILD_CXX_FLAGS += -DDGL_USE_RGBA
 endif
@@ -715,6 +741,7 @@ features:
 	$(call print_available,HAVE_ALSA)
 	$(call print_available,HAVE_DBUS)
 	$(call print_available,HAVE_DGL)
+	$(call print_available,HAVE_EGL)
 	$(call print_available,HAVE_JACK)
 	$(call print_available,HAVE_LIBLO)
 	$(call print_available,HAVE_OPENGL)
@@ -279,6 +279,7 @@ endif
 clap       = $(TARGET_DIR)/$(CLAP_FILENAME)
 shared     = $(TARGET_DIR)/$(NAME)$(LIB_EXT)
 static     = $(TARGET_DIR)/$(NAME).a
+test       = $(TARGET_DIR)/$(NAME)-test$(APP_EXT)
 
 ifeq ($(MACOS),true)
 BUNDLE_RESOURCES = Info.plist PkgInfo Resources/empty.lproj
@@ -318,7 +319,7 @@ SYMBOLS_LV2DSP = -sEXPORTED_FUNCTIONS="['lv2_descriptor','lv2_generate_ttl']"
 SYMBOLS_LV2UI  = -sEXPORTED_FUNCTIONS="['lv2ui_descriptor']"
 SYMBOLS_LV2    = -sEXPORTED_FUNCTIONS="['lv2_descriptor','lv2_generate_ttl','lv2ui_descriptor']"
 SYMBOLS_VST2   = -sEXPORTED_FUNCTIONS="['VSTPluginMain']"
-SYMBOLS_VST3   = -sEXPORTED_FUNCTIONS="['GetPluginFactory','ModuleEntry','ModuleExit']"
+SYMBOLS_VST3   = -sEXPORTED_FUNCTIONS="['GetPluginFactory','ModuleEntry','ModuleExit','vst3_generate_moduleinfo']"
 SYMBOLS_CLAP   = -sEXPORTED_FUNCTIONS="['clap_entry']"
 SYMBOLS_SHARED = -sEXPORTED_FUNCTIONS="['createSharedPlugin']"
 else ifeq ($(WINDOWS),true)
@@ -350,6 +351,13 @@ ifeq ($(DPF_RUNTIME_TESTING),true)
 BUILD_CXX_FLAGS += -DDPF_RUNTIME_TESTING -Wno-pmf-conversions
 endif
 
+# ---------------------------------------------------------------------------------------------------------------------
+# Realtime-safety checks build
+
+ifeq ($(DPF_REALTIME_CHECKS),true)
+BUILD_CXX_FLAGS += -DDPF_REALTIME_CHECKS
+endif
+
 # ---------------------------------------------------------------------------------------------------------------------
 # all needs to be first
 
@@ -631,14 +639,31 @@ endif
 
 vst3: $(vst3) $(vst3files)
 
+# moduleinfo.json is written right after linking, using the same tool as LV2 ttl generation
+ifneq ($(CROSS_COMPILING),true)
+VST3_MODULEINFO_GENERATOR = $(DPF_PATH)/utils/lv2_ttl_generator$(APP_EXT)
+else ifneq ($(EXE_WRAPPER),)
+VST3_MODULEINFO_GENERATOR = $(DPF_PATH)/utils/lv2_ttl_generator$(APP_EXT)
+endif
+
+ifneq ($(VST3_MODULEINFO_GENERATOR),)
+$(VST3_MODULEINFO_GENERATOR): $(DPF_PATH)/utils/lv2-ttl-generator/lv2_ttl_generator.c
+	$(MAKE) -C $(DPF_PATH)/utils/lv2-ttl-generator
+endif
+
 ifeq ($(HAVE_DGL),true)
-$(vst3): $(OBJS_DSP) $(OBJS_UI) $(BUILD_DIR)/DistrhoPluginMain_VST3.cpp.o $(BUILD_DIR)/DistrhoUIMain_VST3.cpp.o $(DGL_LIB)
+$(vst3): $(OBJS_DSP) $(OBJS_UI) $(BUILD_DIR)/DistrhoPluginMain_VST3.cpp.o $(BUILD_DIR)/DistrhoUIMain_VST3.cpp.o $(DGL_LIB) | $(VST3_MODULEINFO_GENERATOR)
 else
-$(vst3): $(OBJS_DSP) $(BUILD_DIR)/DistrhoPluginMain_VST3.cpp.o
+$(vst3): $(OBJS_DSP) $(BUILD_DIR)/DistrhoPluginMain_VST3.cpp.o | $(VST3_MODULEINFO_GENERATOR)
 endif
 	-@mkdir -p $(shell dirname $@)
 	@echo "Creating VST3 plugin for $(NAME)"
 	$(SILENT)$(CXX) $^ $(BUILD_CXX_FLAGS) $(LINK_FLAGS) $(EXTRA_LIBS) $(EXTRA_DSP_LIBS) $(EXTRA_UI_LIBS) $(DGL_LIBS) $(SHARED) $(SYMBOLS_VST3) -o $@
+ifneq ($(VST3_MODULEINFO_GENERATOR),)
+	-@mkdir -p $(TARGET_DIR)/$(NAME).vst3/Contents/Resources
+	@echo "Generating VST3 moduleinfo.json for $(NAME)"
+	$(SILENT)cd $(TARGET_DIR)/$(NAME).vst3/Contents/Resources && $(EXE_WRAPPER) $(abspath $(VST3_MODULEINFO_GENERATOR)) $(abspath $@)
+endif
 
 # ---------------------------------------------------------------------------------------------------------------------
 # CLAP
@@ -691,6 +716,20 @@ endif
 	$(SILENT)rm -f $@
 	$(SILENT)$(AR) crs $@ $^
 
+# ---------------------------------------------------------------------------------------------------------------------
+# Headless test host, built and run on demand
+
+test: $(test)
+	@echo "Running tests for $(NAME)"
+	$(SILENT)$(test) $(TEST_ARGS)
+
+$(test): $(OBJS_DSP) $(BUILD_DIR)/DistrhoPluginMain_TEST.cpp.o
+	-@mkdir -p $(shell dirname $@)
+	@echo "Creating test host for $(NAME)"
+	$(SILENT)$(CXX) $^ $(BUILD_CXX_FLAGS) $(LINK_FLAGS) $(EXTRA_LIBS) $(EXTRA_DSP_LIBS) -lpthread -o $@
+
+.PHONY: test
+
 # ---------------------------------------------------------------------------------------------------------------------
 # macOS files
 
@@ -726,6 +765,7 @@ endif
 -include $(BUILD_DIR)/DistrhoPluginMain_CLAP.cpp.d
 -include $(BUILD_DIR)/DistrhoPluginMain_SHARED.cpp.d
 -include $(BUILD_DIR)/DistrhoPluginMain_STATIC.cpp.d
+-include $(BUILD_DIR)/DistrhoPluginMain_TEST.cpp.d
 
 -include $(BUILD_DIR)/DistrhoUIMain_JACK.cpp.d
 -include $(BUILD_DIR)/DistrhoUIMain_DSSI.cpp.d
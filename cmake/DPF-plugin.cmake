@@ -505,6 +505,22 @@ function(dpf__build_vst3 NAME HAS_UI)
     file(COPY "${DPF_ROOT_DIR}/utils/plugin.bundle/Contents/PkgInfo"
      DESTINATION "${PROJECT_BINARY_DIR}/bin/${NAME}.vst3/Contents")
   endif()
+
+  # moduleinfo.json lets hosts scan the plugin without loading its binary
+  dpf__add_lv2_ttl_generator()
+  add_dependencies("${NAME}-vst3" lv2_ttl_generator)
+
+  separate_arguments(CMAKE_CROSSCOMPILING_EMULATOR)
+
+  file(MAKE_DIRECTORY "${PROJECT_BINARY_DIR}/bin/${NAME}.vst3/Contents/Resources")
+
+  add_custom_command(TARGET "${NAME}-vst3" POST_BUILD
+    COMMAND
+    ${CMAKE_CROSSCOMPILING_EMULATOR}
+    "$<TARGET_FILE:lv2_ttl_generator>"
+    "$<TARGET_FILE:${NAME}-vst3>"
+    WORKING_DIRECTORY "${PROJECT_BINARY_DIR}/bin/${NAME}.vst3/Contents/Resources"
+    DEPENDS lv2_ttl_generator)
 endfunction()
 
 # dpf__build_clap
@@ -34,6 +34,7 @@
 
 struct NVGcontext;
 struct NVGpaint;
+struct NVGLUframebuffer;
 
 
 // -----------------------------------------------------------------------
@@ -312,6 +313,8 @@ public:
 
    /**
       Constructor.
+      Contexts created within the same window graphics context share fonts, images and shader programs,
+      so loading a font or image on one makes it available on all of them.
       @see CreateFlags
     */
     NanoVG(int flags = CREATE_ANTIALIAS);
@@ -884,6 +887,7 @@ public:
 #ifndef DGL_NO_SHARED_RESOURCES
    /**
       Load DPF's internal shared resources for this NanoVG class.
+      Does nothing if another context sharing resources with this one already loaded them.
     */
     virtual bool loadSharedResources();
 #endif
@@ -948,7 +952,7 @@ public:
    /**
       Destructor.
     */
-    ~NanoBaseWidget() override {}
+    ~NanoBaseWidget() override;
 
 protected:
    /**
@@ -973,6 +977,7 @@ private:
 
    /** @internal */
     const bool fUsingParentContext;
+    NVGLUframebuffer* fCachedFramebuffer;
     void displayChildren();
     friend class NanoBaseWidget<TopLevelWidget>;
     friend class NanoBaseWidget<StandaloneWindow>;
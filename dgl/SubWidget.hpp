@@ -161,6 +161,14 @@ public:
     */
     void setSkipDrawing(bool skipDrawing = true);
 
+   /**
+      Indicate that this subwidget should be rendered once into an offscreen texture and reuse it for drawing,
+      until repaint() is called or the subwidget is resized.
+      Useful for complex but mostly static content, like backgrounds, scales and labels.
+      @note Only used by NanoSubWidgets that have their own NanoVG context, when DGL is built with DGL_USE_NANOVG_FBO.
+    */
+    void setCachedRendering(bool cachedRendering = true);
+
 protected:
    /**
       A function called when the subwidget's absolute position is changed.
@@ -171,6 +179,7 @@ private:
     struct PrivateData;
     PrivateData* const pData;
     friend class Widget;
+    template <class BaseWidget> friend class NanoBaseWidget;
     DISTRHO_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SubWidget)
 };
 
@@ -372,6 +372,19 @@ public:
     */
     std::list<SubWidget*> getChildren() const noexcept;
 
+   /**
+      Use a spatial index for finding the children under the pointer, instead of trying each of them in turn.
+      Useful for widgets with a large number of children, like grids of steps or per-band controls.
+
+      When enabled, mouse, motion and scroll events are only given to the children that contain the pointer,
+      plus the child that accepted a mouse press until the button is released.
+      Children the pointer has just left receive a single motion event, so they can update their hover state.
+      This means children must contain their own subwidgets in order for those to receive events.
+
+      The index is updated as needed after children are added, removed, moved, resized or restacked.
+    */
+    void setSubWidgetIndexing(bool indexing = true);
+
    /**
       Request repaint of this widget's area to the window this widget belongs to.
       On the raw Widget class this function does nothing.
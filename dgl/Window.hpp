@@ -412,10 +412,21 @@ public:
    /**
       Render this window's content into a picture file, specified by @a filename.
       Window must be visible and on screen.
-      Written picture format is PPM.
+      Written picture format is binary PPM.
+
+      The frame is captured with captureFrame(), and the file is written on a background thread.
     */
     void renderToPicture(const char* filename);
 
+   /**
+      Capture the window's content on its next repaint.
+      Window must be visible and on screen.
+
+      Pixels are read back asynchronously where possible, without stalling the frame being drawn,
+      so onFrameCaptured() might only be called one frame later.
+    */
+    void captureFrame();
+
    /**
       Run this window as a modal, blocking input events from the parent.
       Only valid for windows that have been created with another window as parent (as passed in the constructor).
@@ -496,6 +507,14 @@ public:
     */
     virtual void onScaleFactorChanged(double scaleFactor);
 
+   /**
+      A function called with the window's content, as requested by captureFrame() or renderToPicture().
+      @a data contains @a width * @a height pixels in RGBA format, starting from the top row.
+      It is only valid during this call.
+      The default implementation does nothing.
+    */
+    virtual void onFrameCaptured(const uint8_t* data, uint32_t width, uint32_t height);
+
 #ifndef DGL_FILE_BROWSER_DISABLED
    /**
       A function called when a path is selected by the user, as triggered by openFileBrowser().
@@ -224,6 +224,9 @@ bool ImageBaseButton<ImageType>::onMotion(const MotionEvent& ev)
 
 // --------------------------------------------------------------------------------------------------------------------
 
+// implemented independently per graphics backend
+struct OpenGLFilmstripTexture;
+
 template <class ImageType>
 struct ImageBaseKnob<ImageType>::PrivateData : public KnobEventHandler::Callback {
     ImageBaseKnob<ImageType>::Callback* callback;
@@ -239,6 +242,7 @@ struct ImageBaseKnob<ImageType>::PrivateData : public KnobEventHandler::Callback
     bool isReady;
 
     uint32_t glTextureId;
+    OpenGLFilmstripTexture* glFilmstrip;
 
     explicit PrivateData(const ImageType& img)
         : callback(nullptr),
@@ -21,6 +21,9 @@
 
 #include "../NanoVG.hpp"
 #include "SubWidgetPrivateData.hpp"
+#include "pugl.hpp"
+
+#include <algorithm>
 
 #ifndef DGL_NO_SHARED_RESOURCES
 # include "Resources.hpp"
@@ -101,6 +104,11 @@ DGL_EXT(PFNGLUNIFORMBLOCKBINDINGPROC,      glUniformBlockBinding)
 # define glGenVertexArrays glGenVertexArraysAPPLE
 #endif
 
+#ifdef DGL_USE_PARTIAL_REDRAW
+// keep the scissor set for the damaged area while drawing
+# define NANOVG_GL_KEEP_SCISSOR 1
+#endif
+
 #include "nanovg/nanovg_gl.h"
 
 #ifdef DGL_USE_NANOVG_FBO
@@ -130,10 +138,19 @@ DGL_EXT(PFNGLUNIFORMBLOCKBINDINGPROC,      glUniformBlockBinding)
 # define nvglImageHandle nvglImageHandleGLES3
 #endif
 
-// -----------------------------------------------------------------------
+#if defined(NANOVG_GL2)
+# define nvgCreateSharedGLfn nvgCreateSharedGL2
+#elif defined(NANOVG_GL3)
+# define nvgCreateSharedGLfn nvgCreateSharedGL3
+#elif defined(NANOVG_GLES2)
+# define nvgCreateSharedGLfn nvgCreateSharedGLES2
+#elif defined(NANOVG_GLES3)
+# define nvgCreateSharedGLfn nvgCreateSharedGLES3
+#endif
 
+// -----------------------------------------------------------------------
 
-NVGcontext* nvgCreateGL(int flags)
+static NVGcontext* nvgCreateSharedGL(NVGcontext* const other, const int flags)
 {
 #if defined(DISTRHO_OS_WINDOWS)
 # if defined(__GNUC__) && (__GNUC__ >= 9)
@@ -205,7 +222,84 @@ DGL_EXT(PFNGLUNIFORMBLOCKBINDINGPROC,      glUniformBlockBinding)
 #  pragma GCC diagnostic pop
 # endif
 #endif
-    return nvgCreateGLfn(flags);
+    return nvgCreateSharedGLfn(other, flags);
+}
+
+NVGcontext* nvgCreateGL(int flags)
+{
+    return nvgCreateSharedGL(nullptr, flags);
+}
+
+// -----------------------------------------------------------------------
+// NanoVG contexts created within the same graphics context share fonts, images and shader programs
+
+struct NanoVGShareGroup {
+    const PuglView* view;
+    std::list<NVGcontext*> contexts;
+};
+
+static std::list<NanoVGShareGroup*> sShareGroups;
+
+static NVGcontext* createSharedContext(const int flags)
+{
+    const PuglView* const view = puglGetCurrentBackendView();
+
+    // not created within a known graphics context, cannot share anything
+    if (view == nullptr)
+        return nvgCreateGL(flags);
+
+    NanoVGShareGroup* group = nullptr;
+
+    for (std::list<NanoVGShareGroup*>::iterator it = sShareGroups.begin(); it != sShareGroups.end(); ++it)
+    {
+        if ((*it)->view == view)
+        {
+            group = *it;
+            break;
+        }
+    }
+
+    if (group == nullptr)
+    {
+        NVGcontext* const context = nvgCreateGL(flags);
+        DISTRHO_SAFE_ASSERT_RETURN(context != nullptr, nullptr);
+
+        group = new NanoVGShareGroup;
+        group->view = view;
+        group->contexts.push_back(context);
+        sShareGroups.push_back(group);
+        return context;
+    }
+
+    NVGcontext* const context = nvgCreateSharedGL(group->contexts.front(), flags);
+    DISTRHO_SAFE_ASSERT_RETURN(context != nullptr, nullptr);
+
+    group->contexts.push_back(context);
+    return context;
+}
+
+static void destroySharedContext(NVGcontext* const context)
+{
+    for (std::list<NanoVGShareGroup*>::iterator it = sShareGroups.begin(); it != sShareGroups.end(); ++it)
+    {
+        NanoVGShareGroup* const group(*it);
+
+        if (std::find(group->contexts.begin(), group->contexts.end(), context) == group->contexts.end())
+            continue;
+
+        group->contexts.remove(context);
+
+        if (group->contexts.empty())
+        {
+            sShareGroups.erase(it);
+            delete group;
+        }
+
+        break;
+    }
+
+    // shared resources are reference-counted, and only deleted with the last context using them
+    nvgDeleteGL(context);
 }
 
 // -----------------------------------------------------------------------
@@ -324,7 +418,7 @@ NanoVG::Paint::operator NVGpaint() const noexcept
 // NanoVG
 
 NanoVG::NanoVG(int flags)
-    : fContext(nvgCreateGL(flags)),
+    : fContext(createSharedContext(flags)),
       fInFrame(false),
       fIsSubWidget(false)
 {
@@ -344,7 +438,7 @@ NanoVG::~NanoVG()
     DISTRHO_CUSTOM_SAFE_ASSERT("Destroying NanoVG context with still active frame", ! fInFrame);
 
     if (fContext != nullptr && ! fIsSubWidget)
-        nvgDeleteGL(fContext);
+        destroySharedContext(fContext);
 }
 
 // -----------------------------------------------------------------------
@@ -1086,6 +1180,15 @@ void NanoBaseWidget<BaseWidget>::displayChildren()
     }
 }
 
+template <class BaseWidget>
+NanoBaseWidget<BaseWidget>::~NanoBaseWidget()
+{
+#ifdef DGL_USE_NANOVG_FBO
+    if (fCachedFramebuffer != nullptr)
+        nvgluDeleteFramebuffer(fCachedFramebuffer);
+#endif
+}
+
 // -----------------------------------------------------------------------
 // NanoSubWidget
 
@@ -1093,7 +1196,8 @@ template <>
 NanoBaseWidget<SubWidget>::NanoBaseWidget(Widget* const parentWidget, int flags)
     : SubWidget(parentWidget),
       NanoVG(flags),
-      fUsingParentContext(false)
+      fUsingParentContext(false),
+      fCachedFramebuffer(nullptr)
 {
     setNeedsViewportScaling();
 }
@@ -1102,7 +1206,8 @@ template <>
 NanoBaseWidget<SubWidget>::NanoBaseWidget(NanoSubWidget* const parentWidget)
     : SubWidget(parentWidget),
       NanoVG(parentWidget->getContext()),
-      fUsingParentContext(true)
+      fUsingParentContext(true),
+      fCachedFramebuffer(nullptr)
 {
     setSkipDrawing();
 }
@@ -1111,7 +1216,8 @@ template <>
 NanoBaseWidget<SubWidget>::NanoBaseWidget(NanoTopLevelWidget* const parentWidget)
     : SubWidget(parentWidget),
       NanoVG(parentWidget->getContext()),
-      fUsingParentContext(true)
+      fUsingParentContext(true),
+      fCachedFramebuffer(nullptr)
 {
     setSkipDrawing();
 }
@@ -1129,6 +1235,93 @@ inline void NanoBaseWidget<SubWidget>::onDisplay()
     }
     else
     {
+#ifdef DGL_USE_NANOVG_FBO
+        if (SubWidget::pData->cachedRendering)
+        {
+            const int width  = static_cast<int>(SubWidget::getWidth());
+            const int height = static_cast<int>(SubWidget::getHeight());
+            DISTRHO_SAFE_ASSERT_RETURN(width > 0 && height > 0,);
+
+            // the texture uses physical pixels, otherwise cached content would look blurry on scaled windows
+            const double scaleFactor = SubWidget::pData->displayScaleFactor;
+            const float pixelRatio = static_cast<float>(scaleFactor);
+            const int fbWidth  = static_cast<int>(width * scaleFactor + 0.5);
+            const int fbHeight = static_cast<int>(height * scaleFactor + 0.5);
+
+            NVGcontext* const context = getContext();
+
+            // size or scale changed, cached content needs a new framebuffer
+            if (fCachedFramebuffer != nullptr)
+            {
+                int cachedWidth = 0, cachedHeight = 0;
+                nvgImageSize(context, fCachedFramebuffer->image, &cachedWidth, &cachedHeight);
+
+                if (cachedWidth != fbWidth || cachedHeight != fbHeight)
+                {
+                    nvgluDeleteFramebuffer(fCachedFramebuffer);
+                    fCachedFramebuffer = nullptr;
+                }
+            }
+
+            if (fCachedFramebuffer == nullptr)
+            {
+                fCachedFramebuffer = nvgluCreateFramebuffer(context, fbWidth, fbHeight, 0);
+                SubWidget::pData->cacheInvalidated = true;
+            }
+
+            // if framebuffer creation failed, draw directly as usual
+            if (fCachedFramebuffer != nullptr)
+            {
+                if (SubWidget::pData->cacheInvalidated)
+                {
+                    GLint previousFramebuffer = 0;
+                    GLint viewport[4] = {};
+                    GLfloat clearColor[4] = {};
+                    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+                    glGetIntegerv(GL_VIEWPORT, viewport);
+                    glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+                    const GLboolean scissorEnabled = glIsEnabled(GL_SCISSOR_TEST);
+
+                    glBindFramebuffer(GL_FRAMEBUFFER, fCachedFramebuffer->fbo);
+                    glViewport(0, 0, fbWidth, fbHeight);
+                    glDisable(GL_SCISSOR_TEST);
+                    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+                    glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+                    NanoVG::beginFrame(SubWidget::getWidth(), SubWidget::getHeight(), pixelRatio);
+                    onNanoDisplay();
+                    displayChildren();
+                    NanoVG::endFrame();
+
+                    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+                    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+                    glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+
+                    if (scissorEnabled)
+                        glEnable(GL_SCISSOR_TEST);
+
+                    SubWidget::pData->cacheInvalidated = false;
+                }
+
+                // cached content is drawn as a single textured quad
+                NanoVG::beginFrame(SubWidget::getWidth(), SubWidget::getHeight(), pixelRatio);
+                nvgBeginPath(context);
+                nvgRect(context, 0.0f, 0.0f, static_cast<float>(width), static_cast<float>(height));
+                nvgFillPaint(context, nvgImagePattern(context, 0.0f, 0.0f,
+                                                      static_cast<float>(width), static_cast<float>(height),
+                                                      0.0f, fCachedFramebuffer->image, 1.0f));
+                nvgFill(context);
+                NanoVG::endFrame();
+                return;
+            }
+        }
+        else if (fCachedFramebuffer != nullptr)
+        {
+            nvgluDeleteFramebuffer(fCachedFramebuffer);
+            fCachedFramebuffer = nullptr;
+        }
+#endif
+
         NanoVG::beginFrame(SubWidget::getWidth(), SubWidget::getHeight());
         onNanoDisplay();
         displayChildren();
@@ -1145,7 +1338,8 @@ template <>
 NanoBaseWidget<TopLevelWidget>::NanoBaseWidget(Window& windowToMapTo, int flags)
     : TopLevelWidget(windowToMapTo),
       NanoVG(flags),
-      fUsingParentContext(false) {}
+      fUsingParentContext(false),
+      fCachedFramebuffer(nullptr) {}
 
 template <>
 inline void NanoBaseWidget<TopLevelWidget>::onDisplay()
@@ -1165,13 +1359,15 @@ template <>
 NanoBaseWidget<StandaloneWindow>::NanoBaseWidget(Application& app, int flags)
     : StandaloneWindow(app),
       NanoVG(flags),
-      fUsingParentContext(false) {}
+      fUsingParentContext(false),
+      fCachedFramebuffer(nullptr) {}
 
 template <>
 NanoBaseWidget<StandaloneWindow>::NanoBaseWidget(Application& app, Window& parentWindow, int flags)
     : StandaloneWindow(app, parentWindow),
       NanoVG(flags),
-      fUsingParentContext(false) {}
+      fUsingParentContext(false),
+      fCachedFramebuffer(nullptr) {}
 
 template <>
 inline void NanoBaseWidget<StandaloneWindow>::onDisplay()
@@ -458,51 +458,190 @@ template class ImageBaseButton<OpenGLImage>;
 // -----------------------------------------------------------------------
 // ImageBaseKnob
 
+// Full filmstrip texture, shared by all knobs of the same window that use the same image
+struct OpenGLFilmstripTexture {
+    const Window* window;
+    const char* rawData;
+    ImageFormat format;
+    Size<uint32_t> size;
+    GLuint textureId;
+    uint32_t refCount;
+};
+
+static std::list<OpenGLFilmstripTexture*> sFilmstripTextures;
+
+static OpenGLFilmstripTexture* acquireFilmstripTexture(const Window& window, const OpenGLImage& image)
+{
+    for (std::list<OpenGLFilmstripTexture*>::iterator it = sFilmstripTextures.begin(); it != sFilmstripTextures.end(); ++it)
+    {
+        OpenGLFilmstripTexture* const filmstrip(*it);
+
+        if (filmstrip->window == &window &&
+            filmstrip->rawData == image.getRawData() &&
+            filmstrip->format == image.getFormat() &&
+            filmstrip->size == image.getSize())
+        {
+            ++filmstrip->refCount;
+            return filmstrip;
+        }
+    }
+
+    // long filmstrips might not fit in a single texture
+    GLint maxTextureSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+
+    if (image.getWidth() > static_cast<uint32_t>(maxTextureSize) ||
+        image.getHeight() > static_cast<uint32_t>(maxTextureSize))
+        return nullptr;
+
+    GLuint textureId = 0;
+    glGenTextures(1, &textureId);
+    DISTRHO_SAFE_ASSERT_RETURN(textureId != 0, nullptr);
+
+    setupOpenGLImage(image, textureId);
+
+    OpenGLFilmstripTexture* const filmstrip = new OpenGLFilmstripTexture;
+    filmstrip->window = &window;
+    filmstrip->rawData = image.getRawData();
+    filmstrip->format = image.getFormat();
+    filmstrip->size = image.getSize();
+    filmstrip->textureId = textureId;
+    filmstrip->refCount = 1;
+
+    sFilmstripTextures.push_back(filmstrip);
+    return filmstrip;
+}
+
+static void releaseFilmstripTexture(OpenGLFilmstripTexture* const filmstrip)
+{
+    if (--filmstrip->refCount != 0)
+        return;
+
+    sFilmstripTextures.remove(filmstrip);
+    glDeleteTextures(1, &filmstrip->textureId);
+    delete filmstrip;
+}
+
+#ifdef DGL_USE_COMPAT_OPENGL
+static void drawTexturedRectangle(const Rectangle<int>& rect, const Rectangle<float>& texRect)
+{
+    const int x = rect.getX();
+    const int y = rect.getY();
+    const int w = rect.getWidth();
+    const int h = rect.getHeight();
+
+    const float u1 = texRect.getX();
+    const float v1 = texRect.getY();
+    const float u2 = u1 + texRect.getWidth();
+    const float v2 = v1 + texRect.getHeight();
+
+    glBegin(GL_QUADS);
+
+    glTexCoord2f(u1, v1);
+    glVertex2d(x, y);
+
+    glTexCoord2f(u2, v1);
+    glVertex2d(x+w, y);
+
+    glTexCoord2f(u2, v2);
+    glVertex2d(x+w, y+h);
+
+    glTexCoord2f(u1, v2);
+    glVertex2d(x, y+h);
+
+    glEnd();
+}
+#endif
+
 template <>
 void ImageBaseKnob<OpenGLImage>::PrivateData::init()
 {
+    // textures are created on first draw, when the window is known
     glTextureId = 0;
-    glGenTextures(1, &glTextureId);
+    glFilmstrip = nullptr;
 }
 
 template <>
 void ImageBaseKnob<OpenGLImage>::PrivateData::cleanup()
 {
-    if (glTextureId == 0)
-        return;
+    if (glFilmstrip != nullptr)
+    {
+        releaseFilmstripTexture(glFilmstrip);
+        glFilmstrip = nullptr;
+    }
 
-    glDeleteTextures(1, &glTextureId);
-    glTextureId = 0;
+    if (glTextureId != 0)
+    {
+        glDeleteTextures(1, &glTextureId);
+        glTextureId = 0;
+    }
 }
 
 template <>
 void ImageBaseKnob<OpenGLImage>::onDisplay()
 {
-    const GraphicsContext& context(getGraphicsContext());
     const float normValue = getNormalizedValue();
 
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, pData->glTextureId);
+    uint32_t layer = 0;
+
+    if (pData->rotationAngle == 0)
+    {
+        DISTRHO_SAFE_ASSERT_RETURN(pData->imgLayerCount > 0,);
+        DISTRHO_SAFE_ASSERT_RETURN(normValue >= 0.0f,);
 
-    if (! pData->isReady)
+        layer = static_cast<uint32_t>(normValue * float(pData->imgLayerCount-1));
+    }
+
+    if (pData->glFilmstrip == nullptr && pData->glTextureId == 0)
     {
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+        pData->glFilmstrip = acquireFilmstripTexture(getWindow(), pData->image);
 
-        static const float trans[] = { 0.0f, 0.0f, 0.0f, 0.0f };
-        glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, trans);
+        // filmstrip too big for a single texture, upload the current layer only
+        if (pData->glFilmstrip == nullptr)
+        {
+            glGenTextures(1, &pData->glTextureId);
+            DISTRHO_SAFE_ASSERT_RETURN(pData->glTextureId != 0,);
+        }
+    }
 
-        glPixelStorei(GL_PACK_ALIGNMENT, 1);
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glEnable(GL_TEXTURE_2D);
+
+    Rectangle<float> texRect(0.0f, 0.0f, 1.0f, 1.0f);
+
+    if (pData->glFilmstrip != nullptr)
+    {
+        // the whole filmstrip is in the texture, pick the layer by texture coordinates
+        glBindTexture(GL_TEXTURE_2D, pData->glFilmstrip->textureId);
 
-        uint32_t imageDataOffset = 0;
+        const float imgWidth  = static_cast<float>(pData->image.getWidth());
+        const float imgHeight = static_cast<float>(pData->image.getHeight());
 
-        if (pData->rotationAngle == 0)
+        // inset by half a texel along the strip, so linear filtering does not bleed in the neighbour layers
+        if (pData->isImgVertical)
+            texRect = Rectangle<float>(0.0f, (static_cast<float>(layer * pData->imgLayerHeight) + 0.5f) / imgHeight,
+                                       static_cast<float>(pData->imgLayerWidth) / imgWidth,
+                                       (static_cast<float>(pData->imgLayerHeight) - 1.0f) / imgHeight);
+        else
+            texRect = Rectangle<float>((static_cast<float>(layer * pData->imgLayerWidth) + 0.5f) / imgWidth, 0.0f,
+                                       (static_cast<float>(pData->imgLayerWidth) - 1.0f) / imgWidth,
+                                       static_cast<float>(pData->imgLayerHeight) / imgHeight);
+    }
+    else
+    {
+        glBindTexture(GL_TEXTURE_2D, pData->glTextureId);
+
+        if (! pData->isReady)
         {
-            DISTRHO_SAFE_ASSERT_RETURN(pData->imgLayerCount > 0,);
-            DISTRHO_SAFE_ASSERT_RETURN(normValue >= 0.0f,);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+
+            static const float trans[] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, trans);
+
+            glPixelStorei(GL_PACK_ALIGNMENT, 1);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
             const uint32_t& v1(pData->isImgVertical ? pData->imgLayerWidth : pData->imgLayerHeight);
             const uint32_t& v2(pData->isImgVertical ? pData->imgLayerHeight : pData->imgLayerWidth);
@@ -510,43 +649,42 @@ void ImageBaseKnob<OpenGLImage>::onDisplay()
             // TODO kImageFormatGreyscale
             const uint32_t layerDataSize   = v1 * v2 * ((pData->image.getFormat() == kImageFormatBGRA ||
                                                      pData->image.getFormat() == kImageFormatRGBA) ? 4 : 3);
-            /*      */ imageDataOffset = layerDataSize * uint32_t(normValue * float(pData->imgLayerCount-1));
-        }
+            const uint32_t imageDataOffset = layerDataSize * layer;
 
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA,
-                     static_cast<GLsizei>(getWidth()), static_cast<GLsizei>(getHeight()), 0,
-                     asOpenGLImageFormat(pData->image.getFormat()), GL_UNSIGNED_BYTE, pData->image.getRawData() + imageDataOffset);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA,
+                         static_cast<GLsizei>(getWidth()), static_cast<GLsizei>(getHeight()), 0,
+                         asOpenGLImageFormat(pData->image.getFormat()), GL_UNSIGNED_BYTE,
+                         pData->image.getRawData() + imageDataOffset);
 
-        pData->isReady = true;
+            pData->isReady = true;
+        }
     }
 
+#ifdef DGL_USE_COMPAT_OPENGL
     const int w = static_cast<int>(getWidth());
     const int h = static_cast<int>(getHeight());
 
     if (pData->rotationAngle != 0)
     {
-#ifdef DGL_USE_COMPAT_OPENGL
         glPushMatrix();
-#endif
 
         const int w2 = w/2;
         const int h2 = h/2;
 
-#ifdef DGL_USE_COMPAT_OPENGL
         glTranslatef(static_cast<float>(w2), static_cast<float>(h2), 0.0f);
         glRotatef(normValue*static_cast<float>(pData->rotationAngle), 0.0f, 0.0f, 1.0f);
-#endif
 
-        Rectangle<int>(-w2, -h2, w, h).draw(context);
+        drawTexturedRectangle(Rectangle<int>(-w2, -h2, w, h), texRect);
 
-#ifdef DGL_USE_COMPAT_OPENGL
         glPopMatrix();
-#endif
     }
     else
     {
-        Rectangle<int>(0, 0, w, h).draw(context);
+        drawTexturedRectangle(Rectangle<int>(0, 0, w, h), texRect);
     }
+#else
+    notImplemented("ImageBaseKnob::onDisplay");
+#endif
 
     glBindTexture(GL_TEXTURE_2D, 0);
     glDisable(GL_TEXTURE_2D);
@@ -566,11 +704,16 @@ template class ImageBaseSwitch<OpenGLImage>;
 
 // -----------------------------------------------------------------------
 
-void SubWidget::PrivateData::display(const uint32_t width, const uint32_t height, const double autoScaleFactor)
+void SubWidget::PrivateData::display(const uint32_t width,
+                                     const uint32_t height,
+                                     const double autoScaleFactor,
+                                     const Rectangle<int>& damage)
 {
     if (skipDrawing)
         return;
 
+    displayScaleFactor = autoScaleFactor;
+
     bool needsDisableScissor = false;
 
     if (needsViewportScaling)
@@ -611,28 +754,46 @@ void SubWidget::PrivateData::display(const uint32_t width, const uint32_t height
                    static_cast<int>(std::round(height * autoScaleFactor)));
 
         // then cut the outer bounds
-        glScissor(static_cast<int>(absolutePos.getX() * autoScaleFactor + 0.5),
-                  static_cast<int>(height - std::round((static_cast<int>(self->getHeight()) + absolutePos.getY())
-                                                       * autoScaleFactor)),
-                  static_cast<int>(std::round(self->getWidth() * autoScaleFactor)),
-                  static_cast<int>(std::round(self->getHeight() * autoScaleFactor)));
+        int x1 = static_cast<int>(absolutePos.getX() * autoScaleFactor + 0.5);
+        int y1 = static_cast<int>(height - std::round((static_cast<int>(self->getHeight()) + absolutePos.getY())
+                                                      * autoScaleFactor));
+        int x2 = x1 + static_cast<int>(std::round(self->getWidth() * autoScaleFactor));
+        int y2 = y1 + static_cast<int>(std::round(self->getHeight() * autoScaleFactor));
+
+       #ifdef DGL_USE_PARTIAL_REDRAW
+        // and the parts not being redrawn, damage uses top-left origin
+        x1 = std::max(x1, damage.getX());
+        y1 = std::max(y1, static_cast<int>(height) - damage.getY() - damage.getHeight());
+        x2 = std::max(x1, std::min(x2, damage.getX() + damage.getWidth()));
+        y2 = std::max(y1, std::min(y2, static_cast<int>(height) - damage.getY()));
+       #endif
+
+        glScissor(x1, y1, x2 - x1, y2 - y1);
 
         glEnable(GL_SCISSOR_TEST);
         needsDisableScissor = true;
     }
 
     // display widget
-    self->onDisplay();
+    selfw->pData->callOnDisplay();
 
     if (needsDisableScissor)
+    {
+       #ifdef DGL_USE_PARTIAL_REDRAW
+        // go back to the damaged area scissor, set before drawing started
+        glScissor(damage.getX(), static_cast<int>(height) - damage.getY() - damage.getHeight(),
+                  damage.getWidth(), damage.getHeight());
+       #else
         glDisable(GL_SCISSOR_TEST);
+       #endif
+    }
 
-    selfw->pData->displaySubWidgets(width, height, autoScaleFactor);
+    selfw->pData->displaySubWidgets(width, height, autoScaleFactor, damage);
 }
 
 // -----------------------------------------------------------------------
 
-void TopLevelWidget::PrivateData::display()
+void TopLevelWidget::PrivateData::display(const Rectangle<int>& damage)
 {
     if (! selfw->pData->visible)
         return;
@@ -657,40 +818,214 @@ void TopLevelWidget::PrivateData::display()
     }
 
     // main widget drawing
-    self->onDisplay();
+    selfw->pData->callOnDisplay();
 
     // now draw subwidgets if there are any
-    selfw->pData->displaySubWidgets(width, height, autoScaleFactor);
+    selfw->pData->displaySubWidgets(width, height, autoScaleFactor, damage);
 }
 
 // -----------------------------------------------------------------------
 
-void Window::PrivateData::renderToPicture(const char* const filename,
-                                          const GraphicsContext&,
-                                          const uint32_t width,
-                                          const uint32_t height)
+#ifdef DGL_USE_PARTIAL_REDRAW
+# if defined(GL_READ_FRAMEBUFFER) && ! defined(DISTRHO_OS_WINDOWS)
+// keep the previous frame in a framebuffer object, so the window itself can stay double-buffered
+#  define DGL_RETAINED_FRAME_USES_FBO
+# endif
+
+# ifdef DGL_RETAINED_FRAME_USES_FBO
+static void destroyRetainedFrameObjects(Window::PrivateData::RetainedFrame* const frame)
+{
+    const GLuint fbo = static_cast<GLuint>(frame->handles[0]);
+    const GLuint rbos[2] = { static_cast<GLuint>(frame->handles[1]), static_cast<GLuint>(frame->handles[2]) };
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteRenderbuffers(2, rbos);
+
+    frame->handles[0] = frame->handles[1] = frame->handles[2] = 0;
+}
+# endif
+
+Window::PrivateData::RetainedFrame::~RetainedFrame()
 {
-    FILE* const f = fopen(filename, "w");
-    DISTRHO_SAFE_ASSERT_RETURN(f != nullptr,);
+   #ifdef DGL_RETAINED_FRAME_USES_FBO
+    if (handles[0] != 0)
+        destroyRetainedFrameObjects(this);
+   #endif
+}
 
-    GLubyte* const pixels = new GLubyte[width * height * 3 * sizeof(GLubyte)];
+bool Window::PrivateData::startRetainedFrame(const GraphicsContext&,
+                                             RetainedFrame*& frame,
+                                             const uint32_t width,
+                                             const uint32_t height)
+{
+   #ifdef DGL_RETAINED_FRAME_USES_FBO
+    DISTRHO_SAFE_ASSERT_RETURN(width != 0 && height != 0, false);
 
-    glFlush();
-    glReadPixels(0, 0, static_cast<GLsizei>(width), static_cast<GLsizei>(height), GL_RGB, GL_UNSIGNED_BYTE, pixels);
+    if (frame != nullptr && frame->width == width && frame->height == height)
+    {
+        // a previous setup failure is not retried until the next resize
+        if (frame->handles[0] == 0)
+            return false;
 
-    fprintf(f, "P3\n%d %d\n255\n", width, height);
-    for (uint32_t y = 0; y < height; y++)
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(frame->handles[0]));
+        return true;
+    }
+
+    if (frame == nullptr)
+    {
+        frame = new RetainedFrame;
+        frame->handles[0] = frame->handles[1] = frame->handles[2] = 0;
+    }
+    else if (frame->handles[0] != 0)
     {
-        for (uint32_t i, x = 0; x < width; x++)
+        destroyRetainedFrameObjects(frame);
+    }
+
+    frame->width = width;
+    frame->height = height;
+
+    GLuint fbo = 0;
+    GLuint rbos[2] = { 0, 0 };
+    glGenFramebuffers(1, &fbo);
+    DISTRHO_SAFE_ASSERT_RETURN(fbo != 0, false);
+    glGenRenderbuffers(2, rbos);
+
+    frame->handles[0] = fbo;
+    frame->handles[1] = rbos[0];
+    frame->handles[2] = rbos[1];
+
+    glBindRenderbuffer(GL_RENDERBUFFER, rbos[0]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, static_cast<GLsizei>(width), static_cast<GLsizei>(height));
+    glBindRenderbuffer(GL_RENDERBUFFER, rbos[1]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, static_cast<GLsizei>(width), static_cast<GLsizei>(height));
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, rbos[0]);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, rbos[1]);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        d_stderr2("Failed to create retained frame framebuffer, partial redraws disabled");
+        destroyRetainedFrameObjects(frame);
+    }
+
+    // new contents are undefined, the whole frame needs drawing
+    return false;
+   #else
+    // unused
+    (void)frame;
+    (void)width;
+    (void)height;
+
+    // full redraws straight into the window
+    return false;
+   #endif
+}
+
+void Window::PrivateData::finishRetainedFrame(const GraphicsContext&, RetainedFrame* const frame)
+{
+   #ifdef DGL_RETAINED_FRAME_USES_FBO
+    if (frame == nullptr || frame->handles[0] == 0)
+        return;
+
+    const GLint width = static_cast<GLint>(frame->width);
+    const GLint height = static_cast<GLint>(frame->height);
+
+    // scissor also applies to blitting, copy everything
+    glDisable(GL_SCISSOR_TEST);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(frame->handles[0]));
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+   #else
+    // unused
+    (void)frame;
+   #endif
+}
+#endif
+
+// -----------------------------------------------------------------------
+
+#if defined(GL_PIXEL_PACK_BUFFER) && ! (defined(DISTRHO_OS_WINDOWS) || defined(DGL_USE_GLES))
+// read back through a pixel buffer, so the frame being drawn is not stalled
+# define DGL_FRAME_CAPTURE_USES_PBO
+#endif
+
+// copy RGBA pixels from OpenGL's bottom-up order into top-down rows
+static void copyFlippedRows(uint8_t* const dst, const uint8_t* const src, const uint32_t width, const uint32_t height)
+{
+    const uint32_t stride = width * 4;
+
+    for (uint32_t y = 0; y < height; ++y)
+        std::memcpy(dst + y * stride, src + (height - y - 1) * stride, stride);
+}
+
+Window::PrivateData::FrameCapture* Window::PrivateData::startFrameCapture(const GraphicsContext&,
+                                                                          const uint32_t width,
+                                                                          const uint32_t height)
+{
+    DISTRHO_SAFE_ASSERT_RETURN(width != 0 && height != 0, nullptr);
+
+    FrameCapture* const capture = new FrameCapture;
+    capture->width = width;
+    capture->height = height;
+    capture->pixels = new uint8_t[width * height * 4];
+    capture->handle = 0;
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+   #ifdef DGL_FRAME_CAPTURE_USES_PBO
+    GLuint pbo = 0;
+    glGenBuffers(1, &pbo);
+
+    if (pbo != 0)
+    {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+        glBufferData(GL_PIXEL_PACK_BUFFER, width * height * 4, nullptr, GL_STREAM_READ);
+        glReadPixels(0, 0, static_cast<GLsizei>(width), static_cast<GLsizei>(height), GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        capture->handle = pbo;
+        return capture;
+    }
+   #endif
+
+    uint8_t* const pixels = new uint8_t[width * height * 4];
+    glReadPixels(0, 0, static_cast<GLsizei>(width), static_cast<GLsizei>(height), GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    copyFlippedRows(capture->pixels, pixels, width, height);
+    delete[] pixels;
+
+    return capture;
+}
+
+bool Window::PrivateData::finishFrameCapture(const GraphicsContext&, FrameCapture* const capture)
+{
+   #ifdef DGL_FRAME_CAPTURE_USES_PBO
+    if (capture->handle != 0)
+    {
+        const GLuint pbo = static_cast<GLuint>(capture->handle);
+        capture->handle = 0;
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+
+        const uint8_t* const data = static_cast<const uint8_t*>(glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY));
+
+        if (data != nullptr)
         {
-            i = 3 * ((height - y - 1) * width + x);
-            fprintf(f, "%3d %3d %3d ", pixels[i], pixels[i+1], pixels[i+2]);
+            copyFlippedRows(capture->pixels, data, capture->width, capture->height);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
         }
-        fprintf(f, "\n");
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        glDeleteBuffers(1, &pbo);
+
+        return data != nullptr;
     }
+   #endif
 
-    delete[] pixels;
-    fclose(f);
+    return true;
 }
 
 // -----------------------------------------------------------------------
@@ -105,6 +105,7 @@ void SubWidget::setAbsolutePos(const Point<int>& pos) noexcept
     ev.pos = pos;
 
     pData->absolutePos = pos;
+    pData->parentWidget->pData->invalidateSubWidgetIndex();
     onPositionChanged(ev);
 
     repaint();
@@ -118,11 +119,13 @@ Point<int> SubWidget::getMargin() const noexcept
 void SubWidget::setMargin(const int x, const int y) noexcept
 {
     pData->margin = Point<int>(x, y);
+    pData->parentWidget->pData->invalidateSubWidgetIndex();
 }
 
 void SubWidget::setMargin(const Point<int>& offset) noexcept
 {
     pData->margin = offset;
+    pData->parentWidget->pData->invalidateSubWidgetIndex();
 }
 
 Widget* SubWidget::getParentWidget() const noexcept
@@ -132,6 +135,19 @@ Widget* SubWidget::getParentWidget() const noexcept
 
 void SubWidget::repaint() noexcept
 {
+    pData->cacheInvalidated = true;
+
+    // subwidgets drawn by their parent are part of its cached content too
+    for (SubWidget* w = this; w->pData->skipDrawing;)
+    {
+        w = dynamic_cast<SubWidget*>(w->pData->parentWidget);
+
+        if (w == nullptr)
+            break;
+
+        w->pData->cacheInvalidated = true;
+    }
+
     if (! isVisible())
         return;
 
@@ -151,6 +167,7 @@ void SubWidget::toBottom()
 
     subwidgets.remove(this);
     subwidgets.insert(subwidgets.begin(), this);
+    pData->parentWidget->pData->invalidateSubWidgetIndex();
 }
 
 void SubWidget::toFront()
@@ -159,6 +176,7 @@ void SubWidget::toFront()
 
     subwidgets.remove(this);
     subwidgets.push_back(this);
+    pData->parentWidget->pData->invalidateSubWidgetIndex();
 }
 
 void SubWidget::setNeedsFullViewportDrawing(const bool needsFullViewportForDrawing)
@@ -177,6 +195,12 @@ void SubWidget::setSkipDrawing(const bool skipDrawing)
     pData->skipDrawing = skipDrawing;
 }
 
+void SubWidget::setCachedRendering(const bool cachedRendering)
+{
+    pData->cachedRendering = cachedRendering;
+    pData->cacheInvalidated = true;
+}
+
 void SubWidget::onPositionChanged(const PositionChangedEvent&)
 {
 }
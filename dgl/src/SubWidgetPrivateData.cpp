@@ -29,14 +29,36 @@ SubWidget::PrivateData::PrivateData(SubWidget* const s, Widget* const pw)
       needsFullViewportForDrawing(false),
       needsViewportScaling(false),
       skipDrawing(false),
-      viewportScaleFactor(0.0)
+      cachedRendering(false),
+      cacheInvalidated(true),
+      viewportScaleFactor(0.0),
+      displayScaleFactor(1.0)
 {
     parentWidget->pData->subWidgets.push_back(self);
+    parentWidget->pData->invalidateSubWidgetIndex();
 }
 
 SubWidget::PrivateData::~PrivateData()
 {
     parentWidget->pData->subWidgets.remove(self);
+    parentWidget->pData->subWidgetRemoved(self);
+}
+
+bool SubWidget::PrivateData::isDamaged(const Rectangle<int>& damage, const double autoScaleFactor) const noexcept
+{
+    // these widgets can draw out of their own bounds
+    if (needsFullViewportForDrawing || (needsViewportScaling && d_isNotZero(viewportScaleFactor)))
+        return true;
+
+    const int x1 = static_cast<int>(std::floor(absolutePos.getX() * autoScaleFactor));
+    const int y1 = static_cast<int>(std::floor(absolutePos.getY() * autoScaleFactor));
+    const int x2 = static_cast<int>(std::ceil((absolutePos.getX() + static_cast<int>(self->getWidth())) * autoScaleFactor));
+    const int y2 = static_cast<int>(std::ceil((absolutePos.getY() + static_cast<int>(self->getHeight())) * autoScaleFactor));
+
+    return x1 < damage.getX() + damage.getWidth()
+        && y1 < damage.getY() + damage.getHeight()
+        && x2 > damage.getX()
+        && y2 > damage.getY();
 }
 
 // --------------------------------------------------------------------------------------------------------------------
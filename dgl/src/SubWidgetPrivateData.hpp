@@ -31,13 +31,19 @@ struct SubWidget::PrivateData {
     bool needsFullViewportForDrawing; // needed for widgets drawing out of bounds
     bool needsViewportScaling; // needed for NanoVG
     bool skipDrawing; // for context reuse in NanoVG based guis
+    bool cachedRendering; // render once into a texture, see setCachedRendering
+    bool cacheInvalidated; // cached texture needs to be rendered again
     double viewportScaleFactor; // auto-scaling for NanoVG
+    double displayScaleFactor; // auto-scaling of the last display call, used for sizing cached textures
 
     explicit PrivateData(SubWidget* const s, Widget* const pw);
     ~PrivateData();
 
+    // check if this widget overlaps the area being redrawn (in window pixels)
+    bool isDamaged(const Rectangle<int>& damage, double autoScaleFactor) const noexcept;
+
     // NOTE display function is different depending on build type, must call displaySubWidgets at the end
-    void display(uint32_t width, uint32_t height, double autoScaleFactor);
+    void display(uint32_t width, uint32_t height, double autoScaleFactor, const Rectangle<int>& damage);
 
     DISTRHO_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PrivateData)
 };
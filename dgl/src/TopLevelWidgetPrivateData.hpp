@@ -31,7 +31,7 @@ struct TopLevelWidget::PrivateData {
 
     explicit PrivateData(TopLevelWidget* self, Window& window);
     ~PrivateData();
-    void display();
+    void display(const Rectangle<int>& damage);
     bool keyboardEvent(const KeyboardEvent& ev);
     bool characterInputEvent(const CharacterInputEvent& ev);
     bool mouseEvent(const MouseEvent& ev);
@@ -199,16 +199,19 @@ VulkanImage& VulkanImage::operator=(const VulkanImage& image) noexcept
 
 // -----------------------------------------------------------------------
 
-void SubWidget::PrivateData::display(const uint32_t width, const uint32_t height, const double autoScaleFactor)
+void SubWidget::PrivateData::display(const uint32_t width,
+                                     const uint32_t height,
+                                     const double autoScaleFactor,
+                                     const Rectangle<int>& damage)
 {
     // TODO
 
-    selfw->pData->displaySubWidgets(width, height, autoScaleFactor);
+    selfw->pData->displaySubWidgets(width, height, autoScaleFactor, damage);
 }
 
 // -----------------------------------------------------------------------
 
-void TopLevelWidget::PrivateData::display()
+void TopLevelWidget::PrivateData::display(const Rectangle<int>& damage)
 {
     if (! selfw->pData->visible)
         return;
@@ -222,19 +225,43 @@ void TopLevelWidget::PrivateData::display()
     // TODO
 
     // main widget drawing
-    self->onDisplay();
+    selfw->pData->callOnDisplay();
 
     // now draw subwidgets if there are any
-    selfw->pData->displaySubWidgets(width, height, autoScaleFactor);
+    selfw->pData->displaySubWidgets(width, height, autoScaleFactor, damage);
 }
 
 // -----------------------------------------------------------------------
 
-void Window::PrivateData::renderToPicture(const char*, const GraphicsContext&, uint32_t, uint32_t)
+Window::PrivateData::FrameCapture* Window::PrivateData::startFrameCapture(const GraphicsContext&, uint32_t, uint32_t)
 {
-    notImplemented("Window::PrivateData::renderToPicture");
+    notImplemented("Window::PrivateData::startFrameCapture");
+    return nullptr;
 }
 
+bool Window::PrivateData::finishFrameCapture(const GraphicsContext&, FrameCapture*)
+{
+    notImplemented("Window::PrivateData::finishFrameCapture");
+    return false;
+}
+
+#ifdef DGL_USE_PARTIAL_REDRAW
+Window::PrivateData::RetainedFrame::~RetainedFrame()
+{
+}
+
+bool Window::PrivateData::startRetainedFrame(const GraphicsContext&, RetainedFrame*&, uint32_t, uint32_t)
+{
+    notImplemented("Window::PrivateData::startRetainedFrame");
+    return false;
+}
+
+void Window::PrivateData::finishRetainedFrame(const GraphicsContext&, RetainedFrame*)
+{
+    notImplemented("Window::PrivateData::finishRetainedFrame");
+}
+#endif
+
 // -----------------------------------------------------------------------
 
 const GraphicsContext& Window::PrivateData::getGraphicsContext() const noexcept
@@ -86,6 +86,9 @@ void Widget::setWidth(uint32_t width) noexcept
     pData->size.setWidth(width);
     onResize(ev);
 
+    if (pData->parentWidget != nullptr)
+        pData->parentWidget->pData->invalidateSubWidgetIndex();
+
     repaint();
 }
 
@@ -101,6 +104,9 @@ void Widget::setHeight(uint32_t height) noexcept
     pData->size.setHeight(height);
     onResize(ev);
 
+    if (pData->parentWidget != nullptr)
+        pData->parentWidget->pData->invalidateSubWidgetIndex();
+
     repaint();
 }
 
@@ -121,6 +127,9 @@ void Widget::setSize(const Size<uint32_t>& size) noexcept
     pData->size = size;
     onResize(ev);
 
+    if (pData->parentWidget != nullptr)
+        pData->parentWidget->pData->invalidateSubWidgetIndex();
+
     repaint();
 }
 
@@ -152,6 +161,11 @@ std::list<SubWidget*> Widget::getChildren() const noexcept
     return pData->subWidgets;
 }
 
+void Widget::setSubWidgetIndexing(const bool indexing)
+{
+    pData->setSubWidgetIndexing(indexing);
+}
+
 void Widget::repaint() noexcept
 {
 }
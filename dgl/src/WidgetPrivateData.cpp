@@ -18,6 +18,16 @@
 #include "SubWidgetPrivateData.hpp"
 #include "../TopLevelWidget.hpp"
 
+#include <algorithm>
+#include <cmath>
+
+#ifdef DGL_DISPLAY_TIMING
+# include <chrono>
+# ifndef DGL_DISPLAY_TIMING_BUDGET
+#  define DGL_DISPLAY_TIMING_BUDGET 0
+# endif
+#endif
+
 
 #define FOR_EACH_SUBWIDGET(it) \
   for (std::list<SubWidget*>::iterator it = subWidgets.begin(); it != subWidgets.end(); ++it)
@@ -25,6 +35,149 @@
 #define FOR_EACH_SUBWIDGET_INV(rit) \
   for (std::list<SubWidget*>::reverse_iterator rit = subWidgets.rbegin(); rit != subWidgets.rend(); ++rit)
 
+// -----------------------------------------------------------------------
+// Uniform grid over the area covered by subwidgets, each cell listing the subwidgets overlapping it
+
+static const uint32_t kSubWidgetIndexMaxCellsPerSide = 64;
+
+struct Widget::PrivateData::SubWidgetIndex {
+    bool dirty;
+    double x1, y1, x2, y2; // indexed area, in the same coordinates as events given to subwidgets
+    double cellWidth, cellHeight;
+    uint32_t columns, rows;
+    std::vector<uint32_t> cellStarts; // offsets into cellWidgets, one per cell plus the end
+    std::vector<SubWidget*> cellWidgets; // subwidgets of each cell, in stacking order
+    std::vector<SubWidget*> hits; // subwidgets under the pointer, top-most first
+    std::vector<SubWidget*> hovered; // subwidgets under the pointer during the last motion event
+    SubWidget* grabbed; // subwidget that accepted a mouse press
+    uint32_t grabbedButton;
+
+    SubWidgetIndex() noexcept
+        : dirty(true),
+          x1(0.0),
+          y1(0.0),
+          x2(0.0),
+          y2(0.0),
+          cellWidth(1.0),
+          cellHeight(1.0),
+          columns(0),
+          rows(0),
+          grabbed(nullptr),
+          grabbedButton(0) {}
+
+    // area where a subwidget receives events, matching SubWidget::contains
+    static void getEventArea(SubWidget* const widget, double& wx1, double& wy1, double& wx2, double& wy2) noexcept
+    {
+        wx1 = widget->getAbsoluteX() - widget->getMargin().getX();
+        wy1 = widget->getAbsoluteY() - widget->getMargin().getY();
+        wx2 = wx1 + widget->getWidth();
+        wy2 = wy1 + widget->getHeight();
+    }
+
+    uint32_t getColumn(const double x) const noexcept
+    {
+        const double column = std::floor((x - x1) / cellWidth);
+        return column <= 0.0 ? 0 : std::min(columns - 1, static_cast<uint32_t>(column));
+    }
+
+    uint32_t getRow(const double y) const noexcept
+    {
+        const double row = std::floor((y - y1) / cellHeight);
+        return row <= 0.0 ? 0 : std::min(rows - 1, static_cast<uint32_t>(row));
+    }
+
+    void rebuild(const std::list<SubWidget*>& subWidgets)
+    {
+        double wx1, wy1, wx2, wy2;
+
+        dirty = false;
+        columns = rows = 0;
+        cellStarts.clear();
+        cellWidgets.clear();
+
+        if (subWidgets.empty())
+            return;
+
+        // hidden subwidgets are indexed too, so that showing them does not need a rebuild
+        x1 = y1 = HUGE_VAL;
+        x2 = y2 = -HUGE_VAL;
+
+        for (std::list<SubWidget*>::const_iterator it = subWidgets.begin(); it != subWidgets.end(); ++it)
+        {
+            getEventArea(*it, wx1, wy1, wx2, wy2);
+            x1 = std::min(x1, wx1);
+            y1 = std::min(y1, wy1);
+            x2 = std::max(x2, wx2);
+            y2 = std::max(y2, wy2);
+        }
+
+        const uint32_t side = std::min(kSubWidgetIndexMaxCellsPerSide,
+                                       static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(subWidgets.size())))));
+        columns = rows = side;
+        cellWidth = std::max(1.0, (x2 - x1) / columns);
+        cellHeight = std::max(1.0, (y2 - y1) / rows);
+
+        // count subwidgets per cell, then fill them in stacking order
+        cellStarts.resize(columns * rows + 1, 0);
+
+        for (std::list<SubWidget*>::const_iterator it = subWidgets.begin(); it != subWidgets.end(); ++it)
+        {
+            getEventArea(*it, wx1, wy1, wx2, wy2);
+
+            for (uint32_t r = getRow(wy1), r2 = getRow(wy2); r <= r2; ++r)
+                for (uint32_t c = getColumn(wx1), c2 = getColumn(wx2); c <= c2; ++c)
+                    ++cellStarts[r * columns + c + 1];
+        }
+
+        for (uint32_t i = 0; i < columns * rows; ++i)
+            cellStarts[i + 1] += cellStarts[i];
+
+        std::vector<uint32_t> cellEnds(cellStarts.begin(), cellStarts.end() - 1);
+        cellWidgets.resize(cellStarts.back());
+
+        for (std::list<SubWidget*>::const_iterator it = subWidgets.begin(); it != subWidgets.end(); ++it)
+        {
+            getEventArea(*it, wx1, wy1, wx2, wy2);
+
+            for (uint32_t r = getRow(wy1), r2 = getRow(wy2); r <= r2; ++r)
+                for (uint32_t c = getColumn(wx1), c2 = getColumn(wx2); c <= c2; ++c)
+                    cellWidgets[cellEnds[r * columns + c]++] = *it;
+        }
+    }
+
+    void findSubWidgetsAt(const double x, const double y)
+    {
+        hits.clear();
+
+        if (columns == 0 || x < x1 || y < y1 || x > x2 || y > y2)
+            return;
+
+        const uint32_t cell = getRow(y) * columns + getColumn(x);
+
+        for (uint32_t i = cellStarts[cell + 1]; i > cellStarts[cell];)
+        {
+            SubWidget* const widget(cellWidgets[--i]);
+
+            if (widget->isVisible() && widget->contains(Point<double>(x - widget->getAbsoluteX() + widget->getMargin().getX(),
+                                                                      y - widget->getAbsoluteY() + widget->getMargin().getY())))
+                hits.push_back(widget);
+        }
+    }
+
+    void addHovered(SubWidget* const widget)
+    {
+        if (std::find(hovered.begin(), hovered.end(), widget) == hovered.end())
+            hovered.push_back(widget);
+    }
+};
+
+template<class Event>
+static inline void setSubWidgetEventPos(Event& ev, SubWidget* const widget, const double x, const double y)
+{
+    ev.pos = Point<double>(x - widget->getAbsoluteX() + widget->getMargin().getX(),
+                           y - widget->getAbsoluteY() + widget->getMargin().getY());
+}
+
 // -----------------------------------------------------------------------
 
 Widget::PrivateData::PrivateData(Widget* const s, TopLevelWidget* const tlw)
@@ -36,7 +189,15 @@ Widget::PrivateData::PrivateData(Widget* const s, TopLevelWidget* const tlw)
       needsScaling(false),
       visible(true),
       size(0, 0),
-      subWidgets() {}
+      subWidgets(),
+      subWidgetIndex(nullptr)
+#ifdef DGL_DISPLAY_TIMING
+    , displayCount(0),
+      displayTimeTotal(0),
+      displayTimeMax(0)
+#endif
+{
+}
 
 Widget::PrivateData::PrivateData(Widget* const s, Widget* const pw)
     : self(s),
@@ -47,15 +208,60 @@ Widget::PrivateData::PrivateData(Widget* const s, Widget* const pw)
       needsScaling(false),
       visible(true),
       size(0, 0),
-      subWidgets() {}
+      subWidgets(),
+      subWidgetIndex(nullptr)
+#ifdef DGL_DISPLAY_TIMING
+    , displayCount(0),
+      displayTimeTotal(0),
+      displayTimeMax(0)
+#endif
+{
+}
 
 Widget::PrivateData::~PrivateData()
 {
+#ifdef DGL_DISPLAY_TIMING
+    if (displayCount != 0)
+        d_stdout("DGL display timing: widget '%s' (id %u) drawn %u times, average %.1f us, max %.1f us",
+                 name != nullptr ? name : "", id, displayCount,
+                 static_cast<double>(displayTimeTotal) / displayCount / 1000.0,
+                 static_cast<double>(displayTimeMax) / 1000.0);
+#endif
+
     subWidgets.clear();
+    delete subWidgetIndex;
     std::free(name);
 }
 
-void Widget::PrivateData::displaySubWidgets(const uint32_t width, const uint32_t height, const double autoScaleFactor)
+void Widget::PrivateData::callOnDisplay()
+{
+#ifdef DGL_DISPLAY_TIMING
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    self->onDisplay();
+
+    const uint64_t elapsed = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+
+    ++displayCount;
+    displayTimeTotal += elapsed;
+
+    if (displayTimeMax < elapsed)
+        displayTimeMax = elapsed;
+
+    if (DGL_DISPLAY_TIMING_BUDGET != 0 && elapsed > DGL_DISPLAY_TIMING_BUDGET * 1000ULL)
+        d_stderr2("DGL display timing: widget '%s' (id %u) took %.1f us, over the %u us budget",
+                  name != nullptr ? name : "", id,
+                  static_cast<double>(elapsed) / 1000.0, static_cast<unsigned int>(DGL_DISPLAY_TIMING_BUDGET));
+#else
+    self->onDisplay();
+#endif
+}
+
+void Widget::PrivateData::displaySubWidgets(const uint32_t width,
+                                            const uint32_t height,
+                                            const double autoScaleFactor,
+                                            const Rectangle<int>& damage)
 {
     if (subWidgets.size() == 0)
         return;
@@ -64,8 +270,14 @@ void Widget::PrivateData::displaySubWidgets(const uint32_t width, const uint32_t
     {
         SubWidget* const subwidget(*it);
 
-        if (subwidget->isVisible())
-            subwidget->pData->display(width, height, autoScaleFactor);
+        if (! subwidget->isVisible())
+            continue;
+
+        if (subwidget->pData->isDamaged(damage, autoScaleFactor))
+            subwidget->pData->display(width, height, autoScaleFactor, damage);
+        // subwidgets are not clipped to their parent bounds, so they still need checking
+        else if (! subwidget->pData->skipDrawing)
+            subwidget->pData->selfw->pData->displaySubWidgets(width, height, autoScaleFactor, damage);
     }
 }
 
@@ -126,6 +338,9 @@ bool Widget::PrivateData::giveMouseEventForSubWidgets(MouseEvent& ev)
         }
     }
 
+    if (subWidgetIndex != nullptr)
+        return giveMouseEventForIndexedSubWidgets(ev, x, y);
+
     FOR_EACH_SUBWIDGET_INV(rit)
     {
         SubWidget* const widget(*rit);
@@ -162,6 +377,9 @@ bool Widget::PrivateData::giveMotionEventForSubWidgets(MotionEvent& ev)
         }
     }
 
+    if (subWidgetIndex != nullptr)
+        return giveMotionEventForIndexedSubWidgets(ev, x, y);
+
     FOR_EACH_SUBWIDGET_INV(rit)
     {
         SubWidget* const widget(*rit);
@@ -198,6 +416,9 @@ bool Widget::PrivateData::giveScrollEventForSubWidgets(ScrollEvent& ev)
         }
     }
 
+    if (subWidgetIndex != nullptr)
+        return giveScrollEventForIndexedSubWidgets(ev, x, y);
+
     FOR_EACH_SUBWIDGET_INV(rit)
     {
         SubWidget* const widget(*rit);
@@ -217,6 +438,172 @@ bool Widget::PrivateData::giveScrollEventForSubWidgets(ScrollEvent& ev)
 
 // -----------------------------------------------------------------------
 
+bool Widget::PrivateData::giveMouseEventForIndexedSubWidgets(MouseEvent& ev, const double x, const double y)
+{
+    SubWidgetIndex* const index = subWidgetIndex;
+    SubWidget* released = nullptr;
+
+    // the subwidget that accepted a press gets its release, wherever the pointer is now
+    if (! ev.press && index->grabbed != nullptr && ev.button == index->grabbedButton)
+    {
+        released = index->grabbed;
+        index->grabbed = nullptr;
+
+        // make sure it gets a motion event for updating its hover state
+        index->addHovered(released);
+
+        if (released->isVisible())
+        {
+            setSubWidgetEventPos(ev, released, x, y);
+
+            if (released->onMouse(ev))
+                return true;
+        }
+    }
+
+    if (index->dirty)
+        index->rebuild(subWidgets);
+
+    index->findSubWidgetsAt(x, y);
+
+    for (std::vector<SubWidget*>::iterator it = index->hits.begin(); it != index->hits.end(); ++it)
+    {
+        SubWidget* const widget(*it);
+
+        if (widget == released)
+            continue;
+
+        setSubWidgetEventPos(ev, widget, x, y);
+
+        if (widget->onMouse(ev))
+        {
+            if (ev.press && index->grabbed == nullptr)
+            {
+                index->grabbed = widget;
+                index->grabbedButton = ev.button;
+            }
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool Widget::PrivateData::giveMotionEventForIndexedSubWidgets(MotionEvent& ev, const double x, const double y)
+{
+    SubWidgetIndex* const index = subWidgetIndex;
+
+    if (index->dirty)
+        index->rebuild(subWidgets);
+
+    index->findSubWidgetsAt(x, y);
+
+    // subwidgets the pointer has left get a last motion event, other subwidgets away from the pointer get nothing
+    for (std::vector<SubWidget*>::iterator it = index->hovered.begin(); it != index->hovered.end(); ++it)
+    {
+        SubWidget* const widget(*it);
+
+        if (widget == index->grabbed || ! widget->isVisible())
+            continue;
+        if (std::find(index->hits.begin(), index->hits.end(), widget) != index->hits.end())
+            continue;
+
+        setSubWidgetEventPos(ev, widget, x, y);
+        widget->onMotion(ev);
+    }
+
+    index->hovered = index->hits;
+
+    if (SubWidget* const widget = index->grabbed)
+    {
+        index->addHovered(widget);
+
+        if (widget->isVisible())
+        {
+            setSubWidgetEventPos(ev, widget, x, y);
+
+            if (widget->onMotion(ev))
+                return true;
+        }
+    }
+
+    for (std::vector<SubWidget*>::iterator it = index->hits.begin(); it != index->hits.end(); ++it)
+    {
+        SubWidget* const widget(*it);
+
+        if (widget == index->grabbed)
+            continue;
+
+        setSubWidgetEventPos(ev, widget, x, y);
+
+        if (widget->onMotion(ev))
+            return true;
+    }
+
+    return false;
+}
+
+bool Widget::PrivateData::giveScrollEventForIndexedSubWidgets(ScrollEvent& ev, const double x, const double y)
+{
+    SubWidgetIndex* const index = subWidgetIndex;
+
+    if (index->dirty)
+        index->rebuild(subWidgets);
+
+    index->findSubWidgetsAt(x, y);
+
+    for (std::vector<SubWidget*>::iterator it = index->hits.begin(); it != index->hits.end(); ++it)
+    {
+        SubWidget* const widget(*it);
+
+        setSubWidgetEventPos(ev, widget, x, y);
+
+        if (widget->onScroll(ev))
+            return true;
+    }
+
+    return false;
+}
+
+void Widget::PrivateData::setSubWidgetIndexing(const bool indexing)
+{
+    if (indexing == (subWidgetIndex != nullptr))
+        return;
+
+    if (indexing)
+    {
+        subWidgetIndex = new SubWidgetIndex();
+    }
+    else
+    {
+        delete subWidgetIndex;
+        subWidgetIndex = nullptr;
+    }
+}
+
+void Widget::PrivateData::invalidateSubWidgetIndex() noexcept
+{
+    if (subWidgetIndex != nullptr)
+        subWidgetIndex->dirty = true;
+}
+
+void Widget::PrivateData::subWidgetRemoved(SubWidget* const widget) noexcept
+{
+    if (subWidgetIndex == nullptr)
+        return;
+
+    subWidgetIndex->dirty = true;
+
+    if (subWidgetIndex->grabbed == widget)
+        subWidgetIndex->grabbed = nullptr;
+
+    std::vector<SubWidget*>& hovered(subWidgetIndex->hovered);
+    hovered.erase(std::remove(hovered.begin(), hovered.end(), widget), hovered.end());
+}
+
+// -----------------------------------------------------------------------
+
 TopLevelWidget* Widget::PrivateData::findTopLevelWidget(Widget* const pw)
 {
     if (pw->pData->topLevelWidget != nullptr)
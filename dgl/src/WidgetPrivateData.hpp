@@ -20,6 +20,7 @@
 #include "../Widget.hpp"
 
 #include <list>
+#include <vector>
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -35,13 +36,25 @@ struct Widget::PrivateData {
     Size<uint32_t> size;
     std::list<SubWidget*> subWidgets;
 
+    // spatial index of subwidgets, see setSubWidgetIndexing
+    struct SubWidgetIndex;
+    SubWidgetIndex* subWidgetIndex;
+#ifdef DGL_DISPLAY_TIMING
+    uint32_t displayCount;
+    uint64_t displayTimeTotal;
+    uint64_t displayTimeMax;
+#endif
+
     // called via TopLevelWidget
     explicit PrivateData(Widget* const s, TopLevelWidget* const tlw);
     // called via SubWidget
     explicit PrivateData(Widget* const s, Widget* const pw);
     ~PrivateData();
 
-    void displaySubWidgets(uint32_t width, uint32_t height, double autoScaleFactor);
+    // calls onDisplay, measuring how long it takes if DGL_DISPLAY_TIMING is enabled
+    void callOnDisplay();
+
+    void displaySubWidgets(uint32_t width, uint32_t height, double autoScaleFactor, const Rectangle<int>& damage);
 
     bool giveKeyboardEventForSubWidgets(const KeyboardEvent& ev);
     bool giveCharacterInputEventForSubWidgets(const CharacterInputEvent& ev);
@@ -49,6 +62,17 @@ struct Widget::PrivateData {
     bool giveMotionEventForSubWidgets(MotionEvent& ev);
     bool giveScrollEventForSubWidgets(ScrollEvent& ev);
 
+    // variants of the above used when a spatial index is enabled
+    bool giveMouseEventForIndexedSubWidgets(MouseEvent& ev, double x, double y);
+    bool giveMotionEventForIndexedSubWidgets(MotionEvent& ev, double x, double y);
+    bool giveScrollEventForIndexedSubWidgets(ScrollEvent& ev, double x, double y);
+
+    void setSubWidgetIndexing(bool indexing);
+    // called when a subwidget changes position, size or stacking order
+    void invalidateSubWidgetIndex() noexcept;
+    // called when a subwidget is about to be destroyed
+    void subWidgetRemoved(SubWidget* widget) noexcept;
+
     static TopLevelWidget* findTopLevelWidget(Widget* const w);
 
     DISTRHO_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PrivateData)
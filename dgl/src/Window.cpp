@@ -436,7 +436,15 @@ void Window::repaint(const Rectangle<uint32_t>& rect) noexcept
 
 void Window::renderToPicture(const char* const filename)
 {
+    std::free(pData->filenameToRenderInto);
     pData->filenameToRenderInto = strdup(filename);
+    captureFrame();
+}
+
+void Window::captureFrame()
+{
+    pData->frameCaptureRequested = true;
+    puglPostRedisplay(pData->view);
 }
 
 void Window::runAsModal(bool blockWait)
@@ -546,6 +554,10 @@ void Window::onScaleFactorChanged(double)
 {
 }
 
+void Window::onFrameCaptured(const uint8_t*, uint32_t, uint32_t)
+{
+}
+
 #ifndef DGL_FILE_BROWSER_DISABLED
 void Window::onFileSelected(const char*)
 {
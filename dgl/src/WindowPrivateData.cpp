@@ -19,6 +19,8 @@
 
 #include "pugl.hpp"
 
+#include "../../distrho/extra/Thread.hpp"
+
 // #define DGL_DEBUG_EVENTS
 
 #if defined(DEBUG) && defined(DGL_DEBUG_EVENTS)
@@ -43,6 +45,76 @@
 #define DEFAULT_WIDTH 640
 #define DEFAULT_HEIGHT 480
 
+// -----------------------------------------------------------------------
+
+struct Window::PrivateData::PictureWriter : Thread {
+    char* filename;
+    uint8_t* pixels;
+    uint32_t width;
+    uint32_t height;
+
+    PictureWriter()
+        : Thread("DGL picture writer"),
+          filename(nullptr),
+          pixels(nullptr),
+          width(0),
+          height(0) {}
+
+    ~PictureWriter() override
+    {
+        stopThread(-1);
+        std::free(filename);
+        delete[] pixels;
+    }
+
+    // takes ownership of filename and pixels
+    void write(char* const f, uint8_t* const p, const uint32_t w, const uint32_t h)
+    {
+        // wait for the previous picture to be written
+        stopThread(-1);
+
+        std::free(filename);
+        delete[] pixels;
+
+        filename = f;
+        pixels = p;
+        width = w;
+        height = h;
+
+        startThread();
+    }
+
+    void run() override
+    {
+        FILE* const f = std::fopen(filename, "wb");
+        DISTRHO_SAFE_ASSERT_RETURN(f != nullptr,);
+
+        std::fprintf(f, "P6\n%u %u\n255\n", width, height);
+
+        // PPM has no alpha channel, convert one row at a time
+        uint8_t* const row = new uint8_t[width * 3];
+
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            const uint8_t* const src = pixels + y * width * 4;
+
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                row[x * 3 + 0] = src[x * 4 + 0];
+                row[x * 3 + 1] = src[x * 4 + 1];
+                row[x * 3 + 2] = src[x * 4 + 2];
+            }
+
+            std::fwrite(row, 3, width, f);
+        }
+
+        delete[] row;
+        std::fclose(f);
+    }
+};
+
+// -----------------------------------------------------------------------
+
 #define FOR_EACH_TOP_LEVEL_WIDGET(it) \
   for (std::list<TopLevelWidget*>::iterator it = topLevelWidgets.begin(); it != topLevelWidgets.end(); ++it)
 
@@ -110,6 +182,12 @@ Window::PrivateData::PrivateData(Application& a, Window* const s)
       waitingForClipboardEvents(false),
       clipboardTypeId(0),
       filenameToRenderInto(nullptr),
+      frameCaptureRequested(false),
+      frameCapture(nullptr),
+#ifdef DGL_USE_PARTIAL_REDRAW
+      retainedFrame(nullptr),
+#endif
+      pictureWriter(nullptr),
 #ifndef DGL_FILE_BROWSER_DISABLED
       fileBrowserHandle(nullptr),
 #endif
@@ -139,6 +217,12 @@ Window::PrivateData::PrivateData(Application& a, Window* const s, PrivateData* c
       waitingForClipboardEvents(false),
       clipboardTypeId(0),
       filenameToRenderInto(nullptr),
+      frameCaptureRequested(false),
+      frameCapture(nullptr),
+#ifdef DGL_USE_PARTIAL_REDRAW
+      retainedFrame(nullptr),
+#endif
+      pictureWriter(nullptr),
 #ifndef DGL_FILE_BROWSER_DISABLED
       fileBrowserHandle(nullptr),
 #endif
@@ -170,6 +254,12 @@ Window::PrivateData::PrivateData(Application& a, Window* const s,
       waitingForClipboardEvents(false),
       clipboardTypeId(0),
       filenameToRenderInto(nullptr),
+      frameCaptureRequested(false),
+      frameCapture(nullptr),
+#ifdef DGL_USE_PARTIAL_REDRAW
+      retainedFrame(nullptr),
+#endif
+      pictureWriter(nullptr),
 #ifndef DGL_FILE_BROWSER_DISABLED
       fileBrowserHandle(nullptr),
 #endif
@@ -202,6 +292,12 @@ Window::PrivateData::PrivateData(Application& a, Window* const s,
       waitingForClipboardEvents(false),
       clipboardTypeId(0),
       filenameToRenderInto(nullptr),
+      frameCaptureRequested(false),
+      frameCapture(nullptr),
+#ifdef DGL_USE_PARTIAL_REDRAW
+      retainedFrame(nullptr),
+#endif
+      pictureWriter(nullptr),
 #ifndef DGL_FILE_BROWSER_DISABLED
       fileBrowserHandle(nullptr),
 #endif
@@ -218,6 +314,26 @@ Window::PrivateData::~PrivateData()
     appData->idleCallbacks.remove(this);
     appData->windows.remove(self);
     std::free(filenameToRenderInto);
+    delete pictureWriter;
+
+    // any pixel buffer still pending goes away together with the graphics context
+    if (frameCapture != nullptr)
+    {
+        delete[] frameCapture->pixels;
+        delete frameCapture;
+    }
+
+#ifdef DGL_USE_PARTIAL_REDRAW
+    // the retained frame has backend objects to release, which needs the graphics context
+    if (retainedFrame != nullptr)
+    {
+        const bool active = view != nullptr && puglBackendEnter(view);
+        delete retainedFrame;
+
+        if (active)
+            puglBackendLeave(view);
+    }
+#endif
 
     if (view == nullptr)
         return;
@@ -598,29 +714,105 @@ void Window::PrivateData::onPuglConfigure(const double width, const double heigh
     puglPostRedisplay(view);
 }
 
-void Window::PrivateData::onPuglExpose()
+void Window::PrivateData::onPuglExpose(const Rectangle<int>& area)
 {
     // DGL_DBG("PUGL: onPuglExpose\n");
 
-    puglOnDisplayPrepare(view);
+    const PuglRect frame = puglGetFrame(view);
+
+#ifdef DGL_USE_PARTIAL_REDRAW
+    Rectangle<int> damage(0, 0, static_cast<int>(frame.width), static_cast<int>(frame.height));
+
+   #ifndef DPF_TEST_WINDOW_CPP
+    // draw on top of the previous frame, if still available only the exposed area needs redrawing
+    if (startRetainedFrame(getGraphicsContext(), retainedFrame,
+                           static_cast<uint32_t>(frame.width), static_cast<uint32_t>(frame.height)))
+    {
+        const int x1 = std::max(0, area.getX());
+        const int y1 = std::max(0, area.getY());
+        const int x2 = std::min(static_cast<int>(frame.width), area.getX() + area.getWidth());
+        const int y2 = std::min(static_cast<int>(frame.height), area.getY() + area.getHeight());
+
+        damage = Rectangle<int>(x1, y1, std::max(0, x2 - x1), std::max(0, y2 - y1));
+    }
+   #endif
+#else
+    const Rectangle<int> damage(0, 0, static_cast<int>(frame.width), static_cast<int>(frame.height));
+
+    // unused
+    (void)area;
+#endif
+
+    const PuglRect prect = {
+        static_cast<PuglCoord>(damage.getX()),
+        static_cast<PuglCoord>(damage.getY()),
+        static_cast<PuglSpan>(damage.getWidth()),
+        static_cast<PuglSpan>(damage.getHeight()),
+    };
+    puglOnDisplayPrepare(view, prect);
 
 #ifndef DPF_TEST_WINDOW_CPP
+    // pixels from the previous frame should be ready by now
+    if (frameCapture != nullptr)
+        completeFrameCapture();
+
     FOR_EACH_TOP_LEVEL_WIDGET(it)
     {
         TopLevelWidget* const widget(*it);
 
         if (widget->isVisible())
-            widget->pData->display();
+            widget->pData->display(damage);
     }
 
-    if (char* const filename = filenameToRenderInto)
+    if (frameCaptureRequested)
     {
-        const PuglRect rect = puglGetFrame(view);
-        filenameToRenderInto = nullptr;
-        renderToPicture(filename, getGraphicsContext(), static_cast<uint32_t>(rect.width), static_cast<uint32_t>(rect.height));
-        std::free(filename);
+        frameCaptureRequested = false;
+        frameCapture = startFrameCapture(getGraphicsContext(),
+                                         static_cast<uint32_t>(frame.width),
+                                         static_cast<uint32_t>(frame.height));
+
+        if (frameCapture != nullptr)
+        {
+            // asynchronous read back, finish it on the next frame
+            if (frameCapture->handle != 0)
+                puglPostRedisplay(view);
+            else
+                completeFrameCapture();
+        }
     }
+
+   #ifdef DGL_USE_PARTIAL_REDRAW
+    // present the whole frame, pugl swaps buffers afterwards
+    finishRetainedFrame(getGraphicsContext(), retainedFrame);
+   #endif
 #endif
+
+    puglOnDisplayFinish(view);
+}
+
+void Window::PrivateData::completeFrameCapture()
+{
+    FrameCapture* const capture = frameCapture;
+    frameCapture = nullptr;
+
+    if (finishFrameCapture(getGraphicsContext(), capture))
+    {
+        self->onFrameCaptured(capture->pixels, capture->width, capture->height);
+
+        if (char* const filename = filenameToRenderInto)
+        {
+            filenameToRenderInto = nullptr;
+
+            if (pictureWriter == nullptr)
+                pictureWriter = new PictureWriter;
+
+            pictureWriter->write(filename, capture->pixels, capture->width, capture->height);
+            capture->pixels = nullptr;
+        }
+    }
+
+    delete[] capture->pixels;
+    delete capture;
 }
 
 void Window::PrivateData::onPuglClose()
@@ -909,8 +1101,9 @@ PuglStatus Window::PrivateData::puglEventCallback(PuglView* const view, const Pu
 
     ///< View must be drawn, a #PuglEventExpose
     case PUGL_EXPOSE:
-        // unused x, y, width, height (double)
-        pData->onPuglExpose();
+        pData->onPuglExpose(Rectangle<int>(event->expose.x, event->expose.y,
+                                           static_cast<int>(event->expose.width),
+                                           static_cast<int>(event->expose.height)));
         break;
 
     ///< View will be closed, a #PuglEventClose
@@ -86,6 +86,33 @@ struct Window::PrivateData : IdleCallback {
     /** Render to a picture file when non-null, automatically free+unset after saving. */
     char* filenameToRenderInto;
 
+    /** Whether to capture the window contents on the next expose. */
+    bool frameCaptureRequested;
+
+    /** Frame capture in progress, completed on the next expose if its pixels are read back asynchronously. */
+    struct FrameCapture {
+        uint32_t width;
+        uint32_t height;
+        uint8_t* pixels;  // RGBA, top row first, valid once finished
+        uintptr_t handle; // backend specific, like an OpenGL pixel buffer
+    }* frameCapture;
+
+#ifdef DGL_USE_PARTIAL_REDRAW
+    /** Offscreen copy of the last frame, partial redraws update it and then present it whole. */
+    struct RetainedFrame {
+        uint32_t width;
+        uint32_t height;
+        uintptr_t handles[3]; // backend specific, like an OpenGL framebuffer and its attachments
+
+        // implemented by the backend, the graphics context must be active
+        ~RetainedFrame();
+    }* retainedFrame;
+#endif
+
+    /** Background thread for writing picture files. */
+    struct PictureWriter;
+    PictureWriter* pictureWriter;
+
 #ifndef DGL_FILE_BROWSER_DISABLED
     /** Handle for file browser dialog operations. */
     FileBrowserHandle fileBrowserHandle;
@@ -168,7 +195,16 @@ struct Window::PrivateData : IdleCallback {
     bool openFileBrowser(const FileBrowserOptions& options);
 #endif
 
-    static void renderToPicture(const char* filename, const GraphicsContext& context, uint32_t width, uint32_t height);
+    // frame capture, start and finish are implemented by the backend
+    static FrameCapture* startFrameCapture(const GraphicsContext& context, uint32_t width, uint32_t height);
+    static bool finishFrameCapture(const GraphicsContext& context, FrameCapture* capture);
+    void completeFrameCapture();
+
+#ifdef DGL_USE_PARTIAL_REDRAW
+    // retained frame, implemented by the backend, start returns false if the previous frame contents are not available
+    static bool startRetainedFrame(const GraphicsContext& context, RetainedFrame*& frame, uint32_t width, uint32_t height);
+    static void finishRetainedFrame(const GraphicsContext& context, RetainedFrame* frame);
+#endif
 
     // modal handling
     void startModal();
@@ -177,7 +213,7 @@ struct Window::PrivateData : IdleCallback {
 
     // pugl events
     void onPuglConfigure(double width, double height);
-    void onPuglExpose();
+    void onPuglExpose(const Rectangle<int>& area);
     void onPuglClose();
     void onPuglFocus(bool focus, CrossingMode mode);
     void onPuglKey(const Widget::KeyboardEvent& ev);
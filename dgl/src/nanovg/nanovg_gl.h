@@ -263,11 +263,14 @@ struct GLNVGtextureContext {  // Textures; shared between shared NanoVG contexts
 	int ntextures;
 	int ctextures;
 	int textureId;
+	GLNVGshader shaders[2];  // Shader programs, indexed by antialias flag; also shared.
+	int shaderRefCount[2];
 };
 typedef struct GLNVGtextureContext GLNVGtextureContext;
 
 struct GLNVGcontext {
 	GLNVGshader shader;
+	int sharedShader;
 	GLNVGtextureContext* textureContext;
 	float view[2];
 	GLuint vertBuf;
@@ -730,16 +733,28 @@ static int glnvg__renderCreate(void* uptr, void* otherUptr)   // Share the textu
 
 	glnvg__checkError(gl, "init");
 
-	if (gl->flags & NVG_ANTIALIAS) {
-		if (glnvg__createShader(&gl->shader, "shader", shaderHeader, "#define EDGE_AA 1\n", fillVertShader, fillFragShader) == 0)
-			return 0;
+	const int shaderIdx = (gl->flags & NVG_ANTIALIAS) ? 1 : 0;
+
+	if (gl->textureContext->shaderRefCount[shaderIdx] > 0) {
+		// Reuse the shader program of the contexts we share textures with.
+		gl->shader = gl->textureContext->shaders[shaderIdx];
 	} else {
-		if (glnvg__createShader(&gl->shader, "shader", shaderHeader, NULL, fillVertShader, fillFragShader) == 0)
-			return 0;
+		if (gl->flags & NVG_ANTIALIAS) {
+			if (glnvg__createShader(&gl->shader, "shader", shaderHeader, "#define EDGE_AA 1\n", fillVertShader, fillFragShader) == 0)
+				return 0;
+		} else {
+			if (glnvg__createShader(&gl->shader, "shader", shaderHeader, NULL, fillVertShader, fillFragShader) == 0)
+				return 0;
+		}
+
+		glnvg__checkError(gl, "uniform locations");
+		glnvg__getUniforms(&gl->shader);
+
+		gl->textureContext->shaders[shaderIdx] = gl->shader;
 	}
 
-	glnvg__checkError(gl, "uniform locations");
-	glnvg__getUniforms(&gl->shader);
+	gl->textureContext->shaderRefCount[shaderIdx]++;
+	gl->sharedShader = 1;
 
 	// Create dynamic vertex array
 #if defined NANOVG_GL3
@@ -1327,7 +1342,9 @@ static void glnvg__renderFlush(void* uptr)
 		glFrontFace(GL_CCW);
 		glEnable(GL_BLEND);
 		glDisable(GL_DEPTH_TEST);
+#ifndef NANOVG_GL_KEEP_SCISSOR
 		glDisable(GL_SCISSOR_TEST);
+#endif
 		glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
 		glStencilMask(0xffffffff);
 		glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
@@ -1668,7 +1685,13 @@ static void glnvg__renderDelete(void* uptr)
 	int i;
 	if (gl == NULL) return;
 
-	glnvg__deleteShader(&gl->shader);
+	if (gl->sharedShader) {
+		const int shaderIdx = (gl->flags & NVG_ANTIALIAS) ? 1 : 0;
+		if (--gl->textureContext->shaderRefCount[shaderIdx] == 0)
+			glnvg__deleteShader(&gl->textureContext->shaders[shaderIdx]);
+	} else {
+		glnvg__deleteShader(&gl->shader);
+	}
 
 #if NANOVG_GL3
 #if NANOVG_GL_USE_UNIFORMBUFFER
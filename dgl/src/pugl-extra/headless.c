@@ -0,0 +1,477 @@
+// Copyright 2012-2022 David Robillard <d@drobilla.net>
+// Copyright 2021-2022 Filipe Coelho <falktx@falktx.com>
+// SPDX-License-Identifier: ISC
+
+// A platform without any window system.
+// Views are never shown on screen, they draw into offscreen surfaces created by the backend,
+// which makes it possible to render and capture widgets on machines without a display server.
+// Events are only generated by pugl itself (create, configure, expose, timers and clipboard),
+// there is no input and puglUpdate does not wait for anything besides the next timer.
+
+#include "headless.h"
+
+#include "../pugl-upstream/src/internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+PuglWorldInternals*
+puglInitWorldInternals(const PuglWorldType type, const PuglWorldFlags flags)
+{
+  PuglWorldInternals* impl =
+    (PuglWorldInternals*)calloc(1, sizeof(PuglWorldInternals));
+
+  impl->scaleFactor = 1.0;
+
+  return impl;
+
+  // unused
+  (void)type;
+  (void)flags;
+}
+
+void*
+puglGetNativeWorld(PuglWorld*)
+{
+  return NULL;
+}
+
+PuglInternals*
+puglInitViewInternals(PuglWorld* const world)
+{
+  return (PuglInternals*)calloc(1, sizeof(PuglInternals));
+
+  // unused
+  (void)world;
+}
+
+PuglStatus
+puglRealize(PuglView* const view)
+{
+  PuglStatus st = PUGL_SUCCESS;
+
+  // Ensure that we do not have a parent, there is nothing to embed into
+  if (view->parent) {
+    return PUGL_FAILURE;
+  }
+
+  if (!view->backend || !view->backend->configure) {
+    return PUGL_BAD_BACKEND;
+  }
+
+  if (view->impl->realized) {
+    return PUGL_FAILURE;
+  }
+
+  // Set the size to the default if it has not already been set
+  if (view->frame.width <= 0.0 && view->frame.height <= 0.0) {
+    PuglViewSize defaultSize = view->sizeHints[PUGL_DEFAULT_SIZE];
+    if (!defaultSize.width || !defaultSize.height) {
+      return PUGL_BAD_CONFIGURATION;
+    }
+
+    view->frame.width  = defaultSize.width;
+    view->frame.height = defaultSize.height;
+  }
+
+  // Configure and create the backend
+  if ((st = view->backend->configure(view)) || (st = view->backend->create(view))) {
+    view->backend->destroy(view);
+    return st;
+  }
+
+  view->impl->realized = true;
+
+  puglDispatchSimpleEvent(view, PUGL_CREATE);
+  puglHeadlessConfigure(view);
+
+  return PUGL_SUCCESS;
+}
+
+PuglStatus
+puglShow(PuglView* const view)
+{
+  if (!view->impl->realized) {
+    const PuglStatus st = puglRealize(view);
+    if (st) {
+      return st;
+    }
+  }
+
+  if (!view->visible) {
+    view->visible = true;
+    puglDispatchSimpleEvent(view, PUGL_MAP);
+  }
+
+  return puglPostRedisplay(view);
+}
+
+PuglStatus
+puglHide(PuglView* const view)
+{
+  if (view->visible) {
+    view->visible = false;
+    puglDispatchSimpleEvent(view, PUGL_UNMAP);
+  }
+
+  return PUGL_SUCCESS;
+}
+
+void
+puglFreeViewInternals(PuglView* const view)
+{
+  if (view && view->impl) {
+    if (view->backend) {
+      view->backend->destroy(view);
+    }
+    free(view->impl->clipboardData);
+    free(view->impl->timers);
+    free(view->impl);
+  }
+}
+
+void
+puglFreeWorldInternals(PuglWorld* const world)
+{
+  free(world->impl);
+}
+
+PuglStatus
+puglGrabFocus(PuglView*)
+{
+  return PUGL_UNSUPPORTED;
+}
+
+double
+puglGetScaleFactor(const PuglView* const view)
+{
+  return view->world->impl->scaleFactor;
+}
+
+double
+puglGetTime(const PuglWorld*)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+void
+puglHeadlessConfigure(PuglView* const view)
+{
+  if (!view->impl->realized) {
+    return;
+  }
+
+  PuglEvent event        = {{PUGL_CONFIGURE, 0}};
+  event.configure.x      = view->frame.x;
+  event.configure.y      = view->frame.y;
+  event.configure.width  = view->frame.width;
+  event.configure.height = view->frame.height;
+  puglDispatchEvent(view, &event);
+
+  view->impl->needsRepaint = true;
+}
+
+static void
+puglHeadlessDispatchTimers(PuglView* const view, const double now)
+{
+  PuglInternals* const impl = view->impl;
+
+  // the event handler may stop timers, so the count is checked again on every iteration
+  for (uint32_t i = 0; i < impl->numTimers; ++i) {
+    PuglTimer* const timer = &impl->timers[i];
+
+    if (timer->nextTime > now) {
+      continue;
+    }
+
+    timer->nextTime = now + timer->period;
+
+    PuglEvent event = {{PUGL_TIMER, 0}};
+    event.timer.id  = timer->id;
+    puglDispatchEvent(view, &event);
+  }
+}
+
+PuglStatus
+puglUpdate(PuglWorld* const world, const double timeout)
+{
+  const double startTime = puglGetTime(world);
+
+  // there are no external events to wait for, so only sleep until the next timer is due
+  if (timeout != 0.0) {
+    double wakeTime = timeout > 0.0 ? startTime + timeout : 0.0;
+
+    for (size_t i = 0; i < world->numViews; ++i) {
+      const PuglInternals* const impl = world->views[i]->impl;
+
+      if (impl->needsRepaint && world->views[i]->visible) {
+        wakeTime = startTime;
+        break;
+      }
+
+      for (uint32_t j = 0; j < impl->numTimers; ++j) {
+        if (wakeTime == 0.0 || impl->timers[j].nextTime < wakeTime) {
+          wakeTime = impl->timers[j].nextTime;
+        }
+      }
+    }
+
+    if (wakeTime > startTime) {
+      const double delay = wakeTime - startTime;
+      struct timespec ts;
+      ts.tv_sec  = (time_t)delay;
+      ts.tv_nsec = (long)((delay - (double)ts.tv_sec) * 1e9);
+      nanosleep(&ts, NULL);
+    }
+  }
+
+  const double now = puglGetTime(world);
+
+  for (size_t i = 0; i < world->numViews; ++i) {
+    PuglView* const view = world->views[i];
+
+    puglHeadlessDispatchTimers(view, now);
+
+    if (!view->visible) {
+      continue;
+    }
+
+    puglDispatchSimpleEvent(view, PUGL_UPDATE);
+
+    if (!view->impl->needsRepaint) {
+      continue;
+    }
+
+    view->impl->needsRepaint = false;
+
+    PuglEvent event     = {{PUGL_EXPOSE, 0}};
+    event.expose.x      = 0;
+    event.expose.y      = 0;
+    event.expose.width  = view->frame.width;
+    event.expose.height = view->frame.height;
+    puglDispatchEvent(view, &event);
+  }
+
+  return PUGL_SUCCESS;
+}
+
+PuglStatus
+puglPostRedisplay(PuglView* const view)
+{
+  view->impl->needsRepaint = true;
+  return PUGL_SUCCESS;
+}
+
+PuglStatus
+puglPostRedisplayRect(PuglView* const view, const PuglRect rect)
+{
+  // the whole view is redrawn, offscreen surfaces are cheap to repaint in full
+  view->impl->needsRepaint = true;
+  return PUGL_SUCCESS;
+
+  // unused
+  (void)rect;
+}
+
+PuglNativeView
+puglGetNativeView(PuglView* const view)
+{
+  return 0;
+
+  // unused
+  (void)view;
+}
+
+PuglStatus
+puglSetWindowTitle(PuglView* const view, const char* const title)
+{
+  puglSetString(&view->title, title);
+  return PUGL_SUCCESS;
+}
+
+PuglStatus
+puglSetSizeHint(PuglView* const    view,
+                const PuglSizeHint hint,
+                const PuglSpan     width,
+                const PuglSpan     height)
+{
+  view->sizeHints[hint].width  = width;
+  view->sizeHints[hint].height = height;
+  return PUGL_SUCCESS;
+}
+
+PuglStatus
+puglStartTimer(PuglView* const view, const uintptr_t id, const double timeout)
+{
+  PuglInternals* const impl = view->impl;
+  const double nextTime = puglGetTime(view->world) + timeout;
+
+  // restart the timer if it already exists
+  for (uint32_t i = 0; i < impl->numTimers; ++i) {
+    if (impl->timers[i].id == id) {
+      impl->timers[i].period = timeout;
+      impl->timers[i].nextTime = nextTime;
+      return PUGL_SUCCESS;
+    }
+  }
+
+  PuglTimer* const timers =
+    (PuglTimer*)realloc(impl->timers, sizeof(PuglTimer) * (impl->numTimers + 1));
+
+  if (timers == NULL) {
+    return PUGL_UNKNOWN_ERROR;
+  }
+
+  impl->timers = timers;
+
+  PuglTimer* const timer = &impl->timers[impl->numTimers++];
+  timer->id = id;
+  timer->period = timeout;
+  timer->nextTime = nextTime;
+  return PUGL_SUCCESS;
+}
+
+PuglStatus
+puglStopTimer(PuglView* const view, const uintptr_t id)
+{
+  PuglInternals* const impl = view->impl;
+
+  for (uint32_t i = 0; i < impl->numTimers; ++i) {
+    if (impl->timers[i].id == id) {
+      memmove(impl->timers + i, impl->timers + (i + 1), sizeof(PuglTimer) * (impl->numTimers - i - 1));
+      --impl->numTimers;
+      return PUGL_SUCCESS;
+    }
+  }
+
+  return PUGL_FAILURE;
+}
+
+PuglStatus
+puglPaste(PuglView* const view)
+{
+  if (view->impl->clipboardData == NULL) {
+    return PUGL_FAILURE;
+  }
+
+  const PuglDataOfferEvent offer = {
+    PUGL_DATA_OFFER,
+    0,
+    puglGetTime(view->world),
+  };
+
+  PuglEvent offerEvent;
+  offerEvent.offer = offer;
+  puglDispatchEvent(view, &offerEvent);
+  return PUGL_SUCCESS;
+}
+
+PuglStatus
+puglAcceptOffer(PuglView* const                 view,
+                const PuglDataOfferEvent* const offer,
+                const uint32_t                  typeIndex)
+{
+  if (typeIndex != 0) {
+    return PUGL_UNSUPPORTED;
+  }
+
+  const PuglDataEvent data = {
+    PUGL_DATA,
+    0,
+    puglGetTime(view->world),
+    0,
+  };
+
+  PuglEvent dataEvent;
+  dataEvent.data = data;
+  puglDispatchEvent(view, &dataEvent);
+  return PUGL_SUCCESS;
+
+  // unused
+  (void)offer;
+}
+
+uint32_t
+puglGetNumClipboardTypes(const PuglView* const view)
+{
+  return view->impl->clipboardData != NULL ? 1u : 0u;
+}
+
+const char*
+puglGetClipboardType(const PuglView* const view, const uint32_t typeIndex)
+{
+  return (typeIndex == 0 && view->impl->clipboardData != NULL)
+           ? "text/plain"
+           : NULL;
+}
+
+const void*
+puglGetClipboard(PuglView* const view,
+                 const uint32_t  typeIndex,
+                 size_t* const   len)
+{
+  if (typeIndex != 0 || view->impl->clipboardData == NULL) {
+    *len = 0;
+    return NULL;
+  }
+
+  *len = view->impl->clipboardSize;
+  return view->impl->clipboardData;
+}
+
+PuglStatus
+puglSetClipboard(PuglView* const   view,
+                 const char* const type,
+                 const void* const data,
+                 const size_t      len)
+{
+  // only utf8 text supported, kept within the view as there is no system clipboard
+  if (type != NULL && strcmp(type, "text/plain") != 0) {
+    return PUGL_UNSUPPORTED;
+  }
+
+  char* const clipboardData = (char*)realloc(view->impl->clipboardData, len + 1);
+
+  if (clipboardData == NULL) {
+    return PUGL_UNKNOWN_ERROR;
+  }
+
+  memcpy(clipboardData, data, len);
+  clipboardData[len] = '\0';
+
+  view->impl->clipboardData = clipboardData;
+  view->impl->clipboardSize = len;
+  return PUGL_SUCCESS;
+}
+
+PuglStatus
+puglSetCursor(PuglView* const view, const PuglCursor cursor)
+{
+  return PUGL_UNSUPPORTED;
+
+  // unused
+  (void)view;
+  (void)cursor;
+}
+
+PuglStatus
+puglSetTransientParent(PuglView* const view, const PuglNativeView parent)
+{
+  view->transientParent = parent;
+  return PUGL_SUCCESS;
+}
+
+PuglStatus
+puglSetPosition(PuglView* const view, const int x, const int y)
+{
+  if (x > INT16_MAX || y > INT16_MAX) {
+    return PUGL_BAD_PARAMETER;
+  }
+
+  view->frame.x = (PuglCoord)x;
+  view->frame.y = (PuglCoord)y;
+  return PUGL_SUCCESS;
+}
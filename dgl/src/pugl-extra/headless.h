@@ -0,0 +1,35 @@
+// Copyright 2012-2022 David Robillard <d@drobilla.net>
+// Copyright 2021-2022 Filipe Coelho <falktx@falktx.com>
+// SPDX-License-Identifier: ISC
+
+#ifndef PUGL_SRC_HEADLESS_H
+#define PUGL_SRC_HEADLESS_H
+
+#include "../pugl-upstream/src/types.h"
+
+#include "pugl/pugl.h"
+
+struct PuglTimer {
+  uintptr_t id;
+  double period;
+  double nextTime;
+};
+
+struct PuglWorldInternalsImpl {
+  double scaleFactor;
+};
+
+struct PuglInternalsImpl {
+  PuglSurface* surface;
+  bool realized;
+  bool needsRepaint;
+  uint32_t numTimers;
+  char* clipboardData;
+  size_t clipboardSize;
+  struct PuglTimer* timers;
+};
+
+// headless specific, notify the view about a new size, as there is no window system to do it for us
+void puglHeadlessConfigure(PuglView* view);
+
+#endif // PUGL_SRC_HEADLESS_H
@@ -0,0 +1,256 @@
+// Copyright 2012-2022 David Robillard <d@drobilla.net>
+// Copyright 2021-2022 Filipe Coelho <falktx@falktx.com>
+// SPDX-License-Identifier: ISC
+
+#include "../pugl-upstream/src/stub.h"
+#include "headless.h"
+
+#include "pugl/pugl.h"
+
+#include <stdlib.h>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+// Rendering happens into an EGL pbuffer the size of the view, recreated when the view is resized.
+// Mesa's surfaceless platform is preferred so that no display server is needed at all,
+// with llvmpipe this works on machines without a GPU.
+
+typedef struct {
+  EGLDisplay display;
+  EGLConfig config;
+  EGLContext context;
+  EGLSurface surface;
+  PuglSpan width;
+  PuglSpan height;
+} PuglHeadlessGlSurface;
+
+static EGLint
+puglHeadlessGlHintValue(const int value)
+{
+  return value == PUGL_DONT_CARE ? EGL_DONT_CARE : value;
+}
+
+static int
+puglHeadlessGlGetAttrib(const EGLDisplay display,
+                        const EGLConfig  config,
+                        const EGLint     attrib)
+{
+  EGLint value = 0;
+  eglGetConfigAttrib(display, config, attrib, &value);
+  return value;
+}
+
+static EGLDisplay
+puglHeadlessGlGetDisplay(void)
+{
+#ifdef EGL_PLATFORM_SURFACELESS_MESA
+  const PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+    (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+
+  if (getPlatformDisplay) {
+    const EGLDisplay display =
+      getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+
+    if (display != EGL_NO_DISPLAY) {
+      return display;
+    }
+  }
+#endif
+
+  return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+static PuglStatus
+puglHeadlessGlConfigure(PuglView* view)
+{
+  PuglInternals* const impl = view->impl;
+
+  const EGLDisplay display = puglHeadlessGlGetDisplay();
+
+  if (display == EGL_NO_DISPLAY) {
+    return PUGL_CREATE_CONTEXT_FAILED;
+  }
+
+  EGLint major, minor;
+  if (eglInitialize(display, &major, &minor) != EGL_TRUE) {
+    return PUGL_CREATE_CONTEXT_FAILED;
+  }
+
+  // clang-format off
+  const EGLint attrs[] = {
+    EGL_SURFACE_TYPE,    EGL_PBUFFER_BIT,
+    EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+    EGL_SAMPLES,         puglHeadlessGlHintValue(view->hints[PUGL_SAMPLES]),
+    EGL_RED_SIZE,        puglHeadlessGlHintValue(view->hints[PUGL_RED_BITS]),
+    EGL_GREEN_SIZE,      puglHeadlessGlHintValue(view->hints[PUGL_GREEN_BITS]),
+    EGL_BLUE_SIZE,       puglHeadlessGlHintValue(view->hints[PUGL_BLUE_BITS]),
+    EGL_ALPHA_SIZE,      puglHeadlessGlHintValue(view->hints[PUGL_ALPHA_BITS]),
+    EGL_DEPTH_SIZE,      puglHeadlessGlHintValue(view->hints[PUGL_DEPTH_BITS]),
+    EGL_STENCIL_SIZE,    puglHeadlessGlHintValue(view->hints[PUGL_STENCIL_BITS]),
+    EGL_NONE
+  };
+  // clang-format on
+
+  EGLConfig config;
+  EGLint numConfigs;
+
+  if (eglChooseConfig(display, attrs, &config, 1, &numConfigs) != EGL_TRUE || numConfigs != 1) {
+    return PUGL_CREATE_CONTEXT_FAILED;
+  }
+
+  PuglHeadlessGlSurface* const surface =
+    (PuglHeadlessGlSurface*)calloc(1, sizeof(PuglHeadlessGlSurface));
+  impl->surface = (PuglSurface*)surface;
+
+  surface->display = display;
+  surface->config = config;
+  surface->context = EGL_NO_CONTEXT;
+  surface->surface = EGL_NO_SURFACE;
+
+  view->hints[PUGL_RED_BITS] =
+    puglHeadlessGlGetAttrib(display, config, EGL_RED_SIZE);
+  view->hints[PUGL_GREEN_BITS] =
+    puglHeadlessGlGetAttrib(display, config, EGL_GREEN_SIZE);
+  view->hints[PUGL_BLUE_BITS] =
+    puglHeadlessGlGetAttrib(display, config, EGL_BLUE_SIZE);
+  view->hints[PUGL_ALPHA_BITS] =
+    puglHeadlessGlGetAttrib(display, config, EGL_ALPHA_SIZE);
+  view->hints[PUGL_DEPTH_BITS] =
+    puglHeadlessGlGetAttrib(display, config, EGL_DEPTH_SIZE);
+  view->hints[PUGL_STENCIL_BITS] =
+    puglHeadlessGlGetAttrib(display, config, EGL_STENCIL_SIZE);
+  view->hints[PUGL_SAMPLES] =
+    puglHeadlessGlGetAttrib(display, config, EGL_SAMPLES);
+
+  // pbuffers have a single color buffer, nothing is ever swapped
+  view->hints[PUGL_DOUBLE_BUFFER] = 0;
+
+  return PUGL_SUCCESS;
+}
+
+static PuglStatus
+puglHeadlessGlCreateSurface(PuglView* view, PuglHeadlessGlSurface* const surface)
+{
+  if (surface->surface != EGL_NO_SURFACE) {
+    eglMakeCurrent(surface->display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroySurface(surface->display, surface->surface);
+  }
+
+  const EGLint attrs[] = {
+    EGL_WIDTH,  view->frame.width,
+    EGL_HEIGHT, view->frame.height,
+    EGL_NONE
+  };
+
+  surface->surface = eglCreatePbufferSurface(surface->display, surface->config, attrs);
+  surface->width = view->frame.width;
+  surface->height = view->frame.height;
+
+  return surface->surface != EGL_NO_SURFACE ? PUGL_SUCCESS : PUGL_CREATE_CONTEXT_FAILED;
+}
+
+PUGL_WARN_UNUSED_RESULT
+static PuglStatus
+puglHeadlessGlEnter(PuglView* view, const PuglExposeEvent* PUGL_UNUSED(expose))
+{
+  PuglHeadlessGlSurface* const surface = (PuglHeadlessGlSurface*)view->impl->surface;
+  if (!surface || surface->context == EGL_NO_CONTEXT) {
+    return PUGL_FAILURE;
+  }
+
+  // follow the view size, there is no window system resizing things for us
+  if (surface->width != view->frame.width || surface->height != view->frame.height) {
+    const PuglStatus st = puglHeadlessGlCreateSurface(view, surface);
+    if (st) {
+      return st;
+    }
+  }
+
+  return eglMakeCurrent(surface->display, surface->surface, surface->surface, surface->context)
+           ? PUGL_SUCCESS
+           : PUGL_FAILURE;
+}
+
+PUGL_WARN_UNUSED_RESULT
+static PuglStatus
+puglHeadlessGlLeave(PuglView* view, const PuglExposeEvent* expose)
+{
+  PuglHeadlessGlSurface* const surface = (PuglHeadlessGlSurface*)view->impl->surface;
+
+  // make sure the frame is complete, so it can be read back at any time
+  if (expose) {
+    glFinish();
+  }
+
+  return eglMakeCurrent(surface->display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT)
+           ? PUGL_SUCCESS
+           : PUGL_FAILURE;
+}
+
+static PuglStatus
+puglHeadlessGlCreate(PuglView* view)
+{
+  PuglHeadlessGlSurface* const surface = (PuglHeadlessGlSurface*)view->impl->surface;
+  const EGLDisplay display = surface->display;
+  const EGLConfig  config  = surface->config;
+
+  if (eglBindAPI(EGL_OPENGL_API) != EGL_TRUE) {
+    return PUGL_CREATE_CONTEXT_FAILED;
+  }
+
+  const EGLint attrs[] = {
+    EGL_CONTEXT_MAJOR_VERSION,
+    view->hints[PUGL_CONTEXT_VERSION_MAJOR],
+
+    EGL_CONTEXT_MINOR_VERSION,
+    view->hints[PUGL_CONTEXT_VERSION_MINOR],
+
+    EGL_CONTEXT_OPENGL_DEBUG,
+    (view->hints[PUGL_USE_DEBUG_CONTEXT] ? EGL_TRUE : EGL_FALSE),
+
+    EGL_CONTEXT_OPENGL_PROFILE_MASK,
+    (view->hints[PUGL_USE_COMPAT_PROFILE]
+       ? EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT
+       : EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT),
+
+    EGL_NONE
+  };
+
+  surface->context = eglCreateContext(display, config, EGL_NO_CONTEXT, attrs);
+
+  if (surface->context == EGL_NO_CONTEXT) {
+    return PUGL_CREATE_CONTEXT_FAILED;
+  }
+
+  return puglHeadlessGlCreateSurface(view, surface);
+}
+
+static void
+puglHeadlessGlDestroy(PuglView* view)
+{
+  PuglHeadlessGlSurface* surface = (PuglHeadlessGlSurface*)view->impl->surface;
+  if (surface) {
+    const EGLDisplay display = surface->display;
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (surface->surface != EGL_NO_SURFACE)
+      eglDestroySurface(display, surface->surface);
+    if (surface->context != EGL_NO_CONTEXT)
+      eglDestroyContext(display, surface->context);
+    // the display is shared by all views, so it is never terminated
+    free(surface);
+    view->impl->surface = NULL;
+  }
+}
+
+const PuglBackend*
+puglGlBackend(void)
+{
+  static const PuglBackend backend = {puglHeadlessGlConfigure,
+                                      puglHeadlessGlCreate,
+                                      puglHeadlessGlDestroy,
+                                      puglHeadlessGlEnter,
+                                      puglHeadlessGlLeave,
+                                      puglStubGetContext};
+  return &backend;
+}
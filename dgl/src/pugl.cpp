@@ -67,6 +67,12 @@
 #  include <vulkan/vulkan.h>
 #  include <vulkan/vulkan_win32.h>
 # endif
+#elif defined(DGL_HEADLESS)
+# include <time.h>
+# ifdef DGL_OPENGL
+#  include <EGL/egl.h>
+#  include <EGL/eglext.h>
+# endif
 #elif defined(HAVE_X11)
 # include <dlfcn.h>
 # include <limits.h>
@@ -154,6 +160,12 @@
 # ifdef DGL_VULKAN
 #  include "pugl-upstream/src/win_vulkan.c"
 # endif
+#elif defined(DGL_HEADLESS)
+# include "pugl-extra/headless.c"
+# include "pugl-extra/headless_stub.c"
+# ifdef DGL_OPENGL
+#  include "pugl-extra/headless_gl.c"
+# endif
 #elif defined(HAVE_X11)
 # include "pugl-upstream/src/x11.c"
 # include "pugl-upstream/src/x11_stub.c"
@@ -171,9 +183,15 @@
 // --------------------------------------------------------------------------------------------------------------------
 // DGL specific, expose backend enter
 
+static PuglView* sCurrentBackendView = nullptr;
+
 bool puglBackendEnter(PuglView* const view)
 {
-    return view->backend->enter(view, nullptr) == PUGL_SUCCESS;
+    if (view->backend->enter(view, nullptr) != PUGL_SUCCESS)
+        return false;
+
+    sCurrentBackendView = view;
+    return true;
 }
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -181,9 +199,20 @@ bool puglBackendEnter(PuglView* const view)
 
 bool puglBackendLeave(PuglView* const view)
 {
+    if (sCurrentBackendView == view)
+        sCurrentBackendView = nullptr;
+
     return view->backend->leave(view, nullptr) == PUGL_SUCCESS;
 }
 
+// --------------------------------------------------------------------------------------------------------------------
+// DGL specific, get current backend view
+
+PuglView* puglGetCurrentBackendView()
+{
+    return sCurrentBackendView;
+}
+
 // --------------------------------------------------------------------------------------------------------------------
 // DGL specific, assigns backend that matches current DGL build
 
@@ -232,6 +261,8 @@ void puglRaiseWindow(PuglView* const view)
 #elif defined(DISTRHO_OS_WINDOWS)
     SetForegroundWindow(view->impl->hwnd);
     SetActiveWindow(view->impl->hwnd);
+#elif defined(DGL_HEADLESS)
+    // nothing
 #elif defined(HAVE_X11)
     XRaiseWindow(view->world->impl->display, view->impl->win);
 #endif
@@ -301,6 +332,8 @@ PuglStatus puglSetGeometryConstraints(PuglView* const view, const uint32_t width
     // nothing
 #elif defined(DISTRHO_OS_WINDOWS)
     // nothing
+#elif defined(DGL_HEADLESS)
+    // nothing
 #elif defined(HAVE_X11)
     if (const PuglStatus status = updateSizeHints(view))
         return status;
@@ -336,6 +369,8 @@ void puglSetResizable(PuglView* const view, const bool resizable)
                                         : GetWindowLong(hwnd, GWL_STYLE) & ~(WS_SIZEBOX | WS_MAXIMIZEBOX);
         SetWindowLong(hwnd, GWL_STYLE, winFlags);
     }
+#elif defined(DGL_HEADLESS)
+    // nothing
 #elif defined(HAVE_X11)
     updateSizeHints(view);
 #endif
@@ -389,6 +424,9 @@ PuglStatus puglSetSizeAndDefault(PuglView* view, uint32_t width, uint32_t height
         // make sure to return context back to ourselves
         puglBackendEnter(view);
     }
+#elif defined(DGL_HEADLESS)
+    // no window system to notify us, the surface follows the new size on the next expose
+    puglHeadlessConfigure(view);
 #elif defined(HAVE_X11)
     // matches upstream pugl, all in one
     if (const Window window = view->impl->win)
@@ -411,14 +449,38 @@ PuglStatus puglSetSizeAndDefault(PuglView* view, uint32_t width, uint32_t height
 // --------------------------------------------------------------------------------------------------------------------
 // DGL specific, build-specific drawing prepare
 
-void puglOnDisplayPrepare(PuglView*)
+void puglOnDisplayPrepare(PuglView* const view, const PuglRect& damage)
 {
   #ifdef DGL_OPENGL
+   #ifdef DGL_USE_PARTIAL_REDRAW
+    // limit clear and drawing to the damaged area, the rest is kept from the previous frame
+    glScissor(damage.x,
+              static_cast<GLint>(view->frame.height) - damage.y - static_cast<GLint>(damage.height),
+              static_cast<GLsizei>(damage.width),
+              static_cast<GLsizei>(damage.height));
+    glEnable(GL_SCISSOR_TEST);
+   #endif
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
    #ifndef DGL_USE_OPENGL3
     glLoadIdentity();
    #endif
   #endif
+
+  #if !defined(DGL_OPENGL) || !defined(DGL_USE_PARTIAL_REDRAW)
+    // unused
+    (void)view;
+    (void)damage;
+  #endif
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// DGL specific, build-specific drawing finish
+
+void puglOnDisplayFinish(PuglView*)
+{
+  #if defined(DGL_OPENGL) && defined(DGL_USE_PARTIAL_REDRAW)
+    glDisable(GL_SCISSOR_TEST);
+  #endif
 }
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -594,6 +656,12 @@ void puglWin32ShowCentered(PuglView* const view)
 
 // --------------------------------------------------------------------------------------------------------------------
 
+#elif defined(DGL_HEADLESS)
+
+// nothing here yet
+
+// --------------------------------------------------------------------------------------------------------------------
+
 #elif defined(HAVE_X11)
 
 PuglStatus puglX11UpdateWithoutExposures(PuglWorld* const world)
@@ -48,6 +48,9 @@ bool puglBackendEnter(PuglView* view);
 // DGL specific, expose backend leave
 bool puglBackendLeave(PuglView* view);
 
+// DGL specific, get the view whose backend was last entered via puglBackendEnter, or null
+PuglView* puglGetCurrentBackendView();
+
 // DGL specific, assigns backend that matches current DGL build
 void puglSetMatchingBackendForCurrentBuild(PuglView* view);
 
@@ -66,8 +69,11 @@ void puglSetResizable(PuglView* view, bool resizable);
 // set window size while also changing default
 PuglStatus puglSetSizeAndDefault(PuglView* view, uint32_t width, uint32_t height);
 
-// DGL specific, build-specific drawing prepare
-void puglOnDisplayPrepare(PuglView* view);
+// DGL specific, build-specific drawing prepare, damage is the area being redrawn (in view pixels)
+void puglOnDisplayPrepare(PuglView* view, const PuglRect& damage);
+
+// DGL specific, build-specific drawing finish
+void puglOnDisplayFinish(PuglView* view);
 
 // DGL specific, build-specific fallback resize
 void puglFallbackOnResize(PuglView* view);
@@ -99,6 +105,10 @@ void puglWin32RestoreWindow(PuglView* view);
 // win32 specific, center view based on parent coordinates (if there is one)
 void puglWin32ShowCentered(PuglView* view);
 
+#elif defined(DGL_HEADLESS)
+
+// nothing here yet
+
 #elif defined(HAVE_X11)
 
 #define DGL_USING_X11
@@ -474,6 +474,135 @@ struct Parameter {
     }
 };
 
+/**
+   Constant parameter enumeration value, used by ParameterDescriptor.
+   @see ParameterEnumerationValue
+ */
+struct ParameterEnumerationDescriptor {
+    float value;
+    const char* label;
+};
+
+/**
+   Constant parameter description, an alternative to filling in Parameter from plugin_initParameter().@n
+   It only holds plain C strings and numbers, so a table of these can be fully built at compile-time.
+
+   When @ref DISTRHO_PLUGIN_WANT_PARAMETER_DESCRIPTORS is enabled,
+   the plugin must define a table named kPluginParameterDescriptors with one entry per parameter.@n
+   DPF then reads parameter details from this table directly,
+   plugin_initParameter() is never called and does not need to be implemented.
+
+   Enumeration values are given as a constant array of ParameterEnumerationDescriptor, like this:
+   @code
+   static constexpr const ParameterEnumerationDescriptor kModeValues[] = {
+       { 0.0f, "Clean" },
+       { 1.0f, "Warm" },
+   };
+   ParameterDescriptor(kParameterIsAutomatable|kParameterIsInteger, "Mode", "mode", 0.0f, 0.0f, 1.0f, kModeValues)
+   @endcode
+   @see Parameter
+ */
+struct ParameterDescriptor {
+    // Hints describing this parameter. @see ParameterHints
+    uint32_t hints;
+    // Full name
+    const char* name;
+    // (Optional) The full name is used when the short one is missing.
+    const char* shortName;
+    // Unique ID. The first character must be [a-zA-Z_], and subsequent characters must be [a-zA-Z0-9_]
+    const char* symbol;
+    // (Optional) The unit of this parameter. This means something like "dB", "kHz" and "ms".@n
+    const char* unit;
+    // (Option & LV2 only)
+    const char* description;
+    ParameterRanges ranges;
+    // (Optional) Enumeration values, pointing to a constant array. @see Parameter::enumValues
+    const ParameterEnumerationDescriptor* enumValues;
+    uint8_t enumCount;
+    // Whether the host is to be restricted to only use enumeration values. @see ParameterEnumerationValues
+    bool enumRestrictedMode;
+    // When set, all other details are filled in by DPF. @see Parameter::initDesignation
+    ParameterDesignation designation;
+    // MIDI CC to use by default on this parameter. @see Parameter::midiCC
+    uint8_t midiCC;
+    // The group id that this parameter belongs to. @see Parameter::groupId
+    uint32_t groupId;
+
+    // Constructor using the most common values, matching the equivalent Parameter constructor.
+    constexpr ParameterDescriptor(uint32_t h, const char* n, const char* s, const char* u,
+                                  float def, float min, float max, uint32_t g = kPortGroupNone) noexcept
+        : hints(h),
+          name(n),
+          shortName(nullptr),
+          symbol(s),
+          unit(u),
+          description(nullptr),
+          ranges(def, min, max),
+          enumValues(nullptr),
+          enumCount(0),
+          enumRestrictedMode(false),
+          designation(kParameterDesignationNull),
+          midiCC(0),
+          groupId(g) {}
+
+    // Constructor using all values.
+    constexpr ParameterDescriptor(uint32_t h, const char* n, const char* sn, const char* s, const char* u,
+                                  const char* d, const ParameterRanges& r, ParameterDesignation des,
+                                  uint8_t cc, uint32_t g) noexcept
+        : hints(h),
+          name(n),
+          shortName(sn),
+          symbol(s),
+          unit(u),
+          description(d),
+          ranges(r),
+          enumValues(nullptr),
+          enumCount(0),
+          enumRestrictedMode(false),
+          designation(des),
+          midiCC(cc),
+          groupId(g) {}
+
+    // Constructor for enumerated parameters, @a ev must be a statically declared array.
+    template <size_t count>
+    constexpr ParameterDescriptor(uint32_t h, const char* n, const char* s,
+                                  float def, float min, float max,
+                                  const ParameterEnumerationDescriptor (&ev)[count],
+                                  bool restricted = true, uint32_t g = kPortGroupNone) noexcept
+        : hints(h),
+          name(n),
+          shortName(nullptr),
+          symbol(s),
+          unit(nullptr),
+          description(nullptr),
+          ranges(def, min, max),
+          enumValues(ev),
+          enumCount(static_cast<uint8_t>(count)),
+          enumRestrictedMode(restricted),
+          designation(kParameterDesignationNull),
+          midiCC(0),
+          groupId(g)
+    {
+        static_assert(count <= UINT8_MAX, "Too many enumeration values");
+    }
+
+    // Constructor for a designated parameter, with all other details filled in by DPF.
+    explicit constexpr ParameterDescriptor(ParameterDesignation des) noexcept
+        : hints(0x0),
+          name(nullptr),
+          shortName(nullptr),
+          symbol(nullptr),
+          unit(nullptr),
+          description(nullptr),
+          ranges(),
+          enumValues(nullptr),
+          enumCount(0),
+          enumRestrictedMode(false),
+          designation(des),
+          midiCC(0),
+          groupId(kPortGroupNone) {}
+};
+
 /**
    Port Group.@n
    Allows to group together audio/cv ports or parameters.
@@ -622,6 +751,26 @@ struct TimePosition {
 # define DISTRHO_PLUGIN_WANT_DIRECT_ACCESS 0
 #endif
 
+#ifndef DISTRHO_PLUGIN_WANT_FRAMEWORK_BYPASS
+# define DISTRHO_PLUGIN_WANT_FRAMEWORK_BYPASS 0
+#endif
+
+#ifndef DISTRHO_PLUGIN_BYPASS_FADE_TIME
+# define DISTRHO_PLUGIN_BYPASS_FADE_TIME 20
+#endif
+
+#ifndef DISTRHO_PLUGIN_WANT_FTZ_DAZ
+# define DISTRHO_PLUGIN_WANT_FTZ_DAZ 0
+#endif
+
+#ifndef DISTRHO_PLUGIN_WANT_INSTANCE_POOL
+# define DISTRHO_PLUGIN_WANT_INSTANCE_POOL 0
+#endif
+
+#ifndef DISTRHO_PLUGIN_INSTANCE_POOL_SIZE
+# define DISTRHO_PLUGIN_INSTANCE_POOL_SIZE 4
+#endif
+
 #ifndef DISTRHO_PLUGIN_WANT_LATENCY
 # define DISTRHO_PLUGIN_WANT_LATENCY 0
 #endif
@@ -630,6 +779,14 @@ struct TimePosition {
 # define DISTRHO_PLUGIN_WANT_MIDI_OUTPUT 0
 #endif
 
+#ifndef DISTRHO_PLUGIN_WANT_OUT_OF_PLACE_PROCESSING
+# define DISTRHO_PLUGIN_WANT_OUT_OF_PLACE_PROCESSING 0
+#endif
+
+#ifndef DISTRHO_PLUGIN_WANT_PARAMETER_DESCRIPTORS
+# define DISTRHO_PLUGIN_WANT_PARAMETER_DESCRIPTORS 0
+#endif
+
 #ifndef DISTRHO_PLUGIN_WANT_PARAMETER_VALUE_CHANGE_REQUEST
 # define DISTRHO_PLUGIN_WANT_PARAMETER_VALUE_CHANGE_REQUEST 0
 #endif
@@ -654,6 +811,10 @@ struct TimePosition {
 # define DISTRHO_UI_USE_NANOVG 0
 #endif
 
+#ifndef DISTRHO_UI_FRAME_RATE
+# define DISTRHO_UI_FRAME_RATE 0
+#endif
+
 // -----------------------------------------------------------------------
 // Define DISTRHO_PLUGIN_HAS_EMBED_UI if needed
 
@@ -679,6 +840,24 @@ struct TimePosition {
 # error Synths need audio output to work!
 #endif
 
+// -----------------------------------------------------------------------
+// Test if framework bypass is used without audio or parameters
+
+#if DISTRHO_PLUGIN_WANT_FRAMEWORK_BYPASS && (DISTRHO_PLUGIN_NUM_INPUTS == 0 || DISTRHO_PLUGIN_NUM_OUTPUTS == 0)
+# error DISTRHO_PLUGIN_WANT_FRAMEWORK_BYPASS requires audio inputs and outputs
+#endif
+
+#if DISTRHO_PLUGIN_WANT_FRAMEWORK_BYPASS && DISTRHO_PLUGIN_NUM_PARAMS == 0
+# error DISTRHO_PLUGIN_WANT_FRAMEWORK_BYPASS requires a parameter with kParameterDesignationBypass
+#endif
+
+// -----------------------------------------------------------------------
+// Test if parameter descriptors are used without parameters
+
+#if DISTRHO_PLUGIN_WANT_PARAMETER_DESCRIPTORS && DISTRHO_PLUGIN_NUM_PARAMS == 0
+# error DISTRHO_PLUGIN_WANT_PARAMETER_DESCRIPTORS requires DISTRHO_PLUGIN_NUM_PARAMS to be set
+#endif
+
 // -----------------------------------------------------------------------
 // Enable MIDI input if synth, test if midi-input disabled when synth
 
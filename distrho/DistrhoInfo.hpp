@@ -379,6 +379,60 @@
  */
 #define DISTRHO_PLUGIN_WANT_DIRECT_ACCESS 0
 
+/**
+   Whether DPF handles bypass instead of the plugin.@n
+   The plugin must still declare a parameter with @ref kParameterDesignationBypass,
+   but its value is kept by DPF and never passed to plugin_setParameterValue().@n
+   Changing bypass does an equal-power cross-fade between the processed and the dry signal,
+   lasting @ref DISTRHO_PLUGIN_BYPASS_FADE_TIME milliseconds.
+   Once fully bypassed, run() is no longer called and the dry signal is delayed by the plugin latency,
+   making bypassed instances nearly free.
+   Blocks with MIDI input still call run() so that note-offs are not lost, but its audio output is replaced.@n
+   Outputs beyond the number of inputs get the dry signal of the last input.@n
+   When leaving bypass, run() is called again but the dry signal is kept for the duration of the plugin latency,
+   so the plugin can fill its buffers with new audio before fading back in.
+   Any other internal state (like reverb tails) continues from where it was when bypass was engaged.
+   @note The bypass designation can only be checked once parameters are initialized,
+         a missing bypass parameter is reported on stderr and leaves bypass unhandled.
+ */
+#define DISTRHO_PLUGIN_WANT_FRAMEWORK_BYPASS 1
+
+/**
+   Bypass cross-fade time in milliseconds, when @ref DISTRHO_PLUGIN_WANT_FRAMEWORK_BYPASS is enabled.@n
+   Defaults to 20 if unset.
+ */
+#define DISTRHO_PLUGIN_BYPASS_FADE_TIME 20
+
+/**
+   Whether to enable flush-to-zero and denormals-are-zero CPU modes during run().@n
+   Denormal numbers commonly show up in IIR filters and feedback loops as signals decay, and are very slow to process.@n
+   When enabled, DPF sets these modes before calling run() and restores the previous ones afterwards,
+   regardless of what the host does. Supported on x86 with SSE2 and on ARM (FPCR/FPSCR).
+   @see ScopedDenormalDisable
+ */
+#define DISTRHO_PLUGIN_WANT_FTZ_DAZ 1
+
+/**
+   Whether new plugin instances are cloned from a process-wide prototype instead of being constructed from scratch.@n
+   When enabled, the plugin must implement plugin_clone(),
+   which is meant to share constructor-time resources (tables, FFT plans, wavetables) with the prototype read-only.@n
+   The prototype is created with createPlugin() on the first instantiation,
+   and @ref DISTRHO_PLUGIN_INSTANCE_POOL_SIZE spare clones once an instance is activated,
+   which the next instances are taken from.@n
+   This makes loading projects with many instances of the same plugin much faster.@n
+   Instances keep the buffer size and sample rate of the first instantiation until they are taken from the pool,
+   at which point plugin_bufferSizeChanged() and plugin_sampleRateChanged() are called if those have changed.
+   @note The prototype and spare instances are destroyed together with the last plugin instance,
+         or when the host unloads the plugin (for formats that have an exit hook, like CLAP and VST3).
+ */
+#define DISTRHO_PLUGIN_WANT_INSTANCE_POOL 1
+
+/**
+   Number of spare instances created ahead of time when @ref DISTRHO_PLUGIN_WANT_INSTANCE_POOL is enabled.@n
+   Defaults to 4 if unset, can be 0 for cloning every instance on demand.
+ */
+#define DISTRHO_PLUGIN_INSTANCE_POOL_SIZE 4
+
 /**
    Whether the plugin introduces latency during audio or midi processing.
    @see Plugin::setLatency(uint32_t)
@@ -397,6 +451,30 @@
  */
 #define DISTRHO_PLUGIN_WANT_MIDI_OUTPUT 1
 
+/**
+   Whether the plugin requires its audio inputs to never share buffers with its audio outputs.@n
+   When enabled, inputs that the host passes in-place are first copied into scratch buffers owned by DPF,
+   which are allocated ahead of time for the current buffer size.@n
+   Plugins that can handle in-place processing should leave this disabled and check plugin_isInPlace() instead,
+   so the copy is only done when really needed.
+ */
+#define DISTRHO_PLUGIN_WANT_OUT_OF_PLACE_PROCESSING 1
+
+/**
+   Whether the plugin describes its parameters with a constant table instead of plugin_initParameter().@n
+   When enabled, the plugin must define the table like this:
+   @code
+   const ParameterDescriptor kPluginParameterDescriptors[DISTRHO_PLUGIN_NUM_PARAMS] = {
+       ParameterDescriptor(kParameterIsAutomatable, "Gain", "gain", "dB", 0.0f, -60.0f, 12.0f),
+       ParameterDescriptor(kParameterDesignationBypass),
+   };
+   @endcode
+   Parameter details are then built once per binary without calling into the plugin,
+   which keeps instance creation cheap for plugins with many parameters.
+   @see ParameterDescriptor
+ */
+#define DISTRHO_PLUGIN_WANT_PARAMETER_DESCRIPTORS 1
+
 /**
    Whether the plugin wants to change its own parameter inputs.@n
    Not all hosts or plugin formats support this,
@@ -469,6 +547,18 @@
  */
 #define DISTRHO_UI_USER_RESIZABLE 1
 
+/**
+   Target rate, in frames per second, for delivering parameter changes to the %UI.@n
+   When set, parameter changes coming from the host are not passed to the %UI right away,
+   but kept until the next frame so that only the last value of each parameter is delivered,
+   followed by a single UI::parameterChangesBatch() call.
+   Changes are held while the %UI is hidden, and delivered once it becomes visible again.
+
+   Frames are driven by the host idle calls, so the effective rate can be lower than the one set here.
+   By default this is 0, which delivers every parameter change as soon as it arrives.
+ */
+#define DISTRHO_UI_FRAME_RATE 30
+
 /**
    The %UI URI when exporting in LV2 format.@n
    By default this is set to @ref DISTRHO_PLUGIN_URI with "#UI" as suffix.
@@ -658,6 +748,22 @@
  */
 #define DPF_RUNTIME_TESTING
 
+/**
+   Whether to enable realtime-safety checks.@n
+   This will report, with a backtrace, any memory allocation, deallocation or blocking mutex lock done by the plugin
+   binary while inside its run() function, which are the most common cause of audio dropouts.@n
+   Meant for debugging only, as the checks themselves slow down every allocation.@n
+   Under DPF makefiles this can be enabled by using `make DPF_REALTIME_CHECKS=true`,
+   it is always enabled for the headless test host (`make test`).
+
+   @note Reporting needs glibc, so it only works on Linux and similar systems.
+         Backtrace addresses of non-exported functions can be resolved with `addr2line`.
+   @note Only calls made from the plugin binary itself are checked, as the hooks are not exported.
+         Allocations or locks happening inside other shared libraries (like non-inlined C++ runtime functions)
+         are not reported.
+ */
+#define DPF_REALTIME_CHECKS
+
 /**
    Whether to show parameter outputs in the VST2 plugins.@n
    This is disabled (unset) by default, as the VST2 format has no notion of read-only parameters.
@@ -684,6 +790,43 @@
  */
 #define DGL_USE_OPENGL3
 
+/**
+   Whether to only redraw the damaged area of a window, instead of the full window on every repaint.@n
+   Subwidgets outside of the area posted with SubWidget::repaint() are skipped,
+   and drawing is scissored to that area, so a small widget updating often does not re-render the whole window.@n
+   OpenGL windows keep the previous frame in an offscreen framebuffer, which is copied to the window on every repaint.@n
+   Where framebuffer objects are not available (or on Windows for now) the whole window is still redrawn each time.
+   Under DPF makefiles this can be enabled by using `make USE_PARTIAL_REDRAW=true` on the dgl build step.
+
+   @note Widgets must not draw outside of their own bounds unless SubWidget::setNeedsFullViewportDrawing() is used.
+ */
+#define DGL_USE_PARTIAL_REDRAW
+
+/**
+   Whether to measure how long each widget takes to draw itself.@n
+   A summary with the number of onDisplay() calls and their average and maximum time is printed when a widget is destroyed.
+   Setting `DGL_DISPLAY_TIMING_BUDGET` to a number of microseconds also reports every single call going over it.@n
+   Only the CPU side is measured, GPU work queued by the widget might still be pending when onDisplay() returns.
+   Under DPF makefiles this can be enabled by using `make USE_DISPLAY_TIMING=true` on the dgl build step.
+
+   @note Together with a headless build (see DGL_HEADLESS), Window::renderToPicture() and `utils/ppm-compare.py`
+         this can be used for UI regression tests on machines without a display server or GPU.
+ */
+#define DGL_DISPLAY_TIMING
+
+/**
+   Whether to build DGL without any window system, rendering into offscreen surfaces instead.@n
+   Windows are never shown on screen, but are drawn as usual and can be captured with Window::captureFrame()
+   or Window::renderToPicture(), so widgets can be rendered and compared on CI machines without a display server.
+   There is no user input, timers and repaints are processed by Application::idle().@n
+   Only OpenGL (and stub) builds on Linux are supported, the OpenGL backend uses EGL pbuffers,
+   with Mesa's surfaceless platform when available so that software rendering works without a GPU.
+   Under DPF makefiles this can be enabled by using `make USE_HEADLESS=true` on the dgl build step,
+   the resulting libraries are placed in `build-headless`.
+   See `tests/WidgetRendering.cpp` for an example.
+ */
+#define DGL_HEADLESS
+
 /** @} */
 
 /* ------------------------------------------------------------------------------------------------------------
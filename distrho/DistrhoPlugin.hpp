@@ -99,6 +99,33 @@ extern bool plugin_canRequestParameterValueChanges(void*);
 extern bool plugin_requestParameterValueChange(void*, uint32_t index, float value);
 #endif
 
+/**
+    Get the audio inputs that the host reported as silent (all zeros) for the current run() call.@n
+    Bit N is set when audio input N is silent, only the first 64 inputs are reported.@n
+    This allows skipping expensive processing, for example while a track is not playing anything.@n
+    This function must only be called during run().
+    @note Only CLAP and VST3 hosts can report silence, a zero mask does not mean inputs have signal.
+*/
+extern uint64_t plugin_getInputSilenceMask(void*);
+
+/**
+    Report audio outputs that are silent (all zeros) for the current run() call.@n
+    Bit N is set when audio output N is silent, only the first 64 outputs can be reported.@n
+    The output buffers must still be filled with zeros, this is only a hint for the host to skip further processing.@n
+    This function must only be called during run(), the mask is reset before each run() call.
+    @note Only CLAP and VST3 hosts make use of this information.
+*/
+extern void plugin_setOutputSilenceMask(void*, uint64_t mask);
+
+/**
+    Check if audio input @a channel shares its buffer with an audio output for the current run() call.@n
+    When true, writing to any output may overwrite the input data, so it must be read (or copied) first.@n
+    Hosts commonly do this to save memory, but it is never guaranteed either way.@n
+    This function must only be called during run().
+    @see DISTRHO_PLUGIN_WANT_OUT_OF_PLACE_PROCESSING
+*/
+extern bool plugin_isInPlace(void*, uint32_t channel);
+
 /* --------------------------------------------------------------------------------------------------------
 * Information */
 
@@ -160,16 +187,28 @@ extern int64_t plugin_getUniqueId();
 */
 extern void plugin_initAudioPort(void*, bool input, uint32_t index, AudioPort& port);
 
+#if DISTRHO_PLUGIN_WANT_PARAMETER_DESCRIPTORS
+/**
+    Constant table describing all parameters, to be defined by the plugin.@n
+    Used instead of plugin_initParameter() when DISTRHO_PLUGIN_WANT_PARAMETER_DESCRIPTORS is enabled.
+    @see ParameterDescriptor
+*/
+extern const ParameterDescriptor kPluginParameterDescriptors[DISTRHO_PLUGIN_NUM_PARAMS];
+#else
 /**
     Initialize the parameter @a index.@n
-    This function will be called once, shortly after the plugin is created.
+    This function will be called once, shortly after the first plugin instance is created.@n
+    Parameter details are shared between all instances of the plugin,
+    so they must not depend on the state of the instance passed as first argument.
 */
 extern void plugin_initParameter(void*, uint32_t index, Parameter& parameter);
+#endif
 
 /**
     Initialize the port group @a groupId.@n
     This function will be called once,
-    shortly after the plugin is created and all audio ports and parameters have been enumerated.
+    shortly after the first plugin instance is created and all audio ports and parameters have been enumerated.@n
+    Like parameters, port groups are shared between all instances of the plugin.
 */
 extern void plugin_initPortGroup(void*, uint32_t groupId, PortGroup& portGroup);
 
@@ -260,6 +299,16 @@ extern void* createPlugin();
 extern void destroyPlugin(void*);
 extern struct PluginPrivateData* getPluginPrivateData(void*);
 
+#if DISTRHO_PLUGIN_WANT_INSTANCE_POOL
+/**
+   Create a new plugin instance from @a prototype, which was previously created with createPlugin().@n
+   Resources built by the constructor can be shared with the prototype, as long as they are never modified.@n
+   The new instance must be in the same state as one created by createPlugin(), with its own PluginPrivateData.
+   @note This function is only available if DISTRHO_PLUGIN_WANT_INSTANCE_POOL is enabled.
+ */
+extern void* plugin_clone(const void* prototype);
+#endif
+
 /** @} */
 
 // -----------------------------------------------------------------------------------------------------------
@@ -15,8 +15,18 @@
  */
 
 #include "DistrhoPluginInfo.h"
+
+// the headless test host always checks for realtime-safety
+#if defined(DISTRHO_PLUGIN_TARGET_TEST) && ! defined(DPF_REALTIME_CHECKS)
+# define DPF_REALTIME_CHECKS
+#endif
+
 #include "src/DistrhoPlugin.cpp"
 
+#ifdef DPF_REALTIME_CHECKS
+# include "src/DistrhoRealtimeChecker.cpp"
+#endif
+
 #if defined(DISTRHO_PLUGIN_TARGET_CARLA)
 # include "src/DistrhoPluginCarla.cpp"
 #elif defined(DISTRHO_PLUGIN_TARGET_CLAP)
@@ -37,6 +47,8 @@ DISTRHO_PLUGIN_EXPORT Plugin* createSharedPlugin();
 DISTRHO_PLUGIN_EXPORT Plugin* createSharedPlugin() { return createPlugin(); }
 #elif defined(DISTRHO_PLUGIN_TARGET_STATIC)
 Plugin* createStaticPlugin() { return createPlugin(); }
+#elif defined(DISTRHO_PLUGIN_TARGET_TEST)
+# include "src/DistrhoPluginTest.cpp"
 #else
 # error unsupported format
 #endif
@@ -225,6 +225,15 @@ protected:
     */
     virtual void parameterChanged(uint32_t index, float value) = 0;
 
+#if DISTRHO_UI_FRAME_RATE != 0
+   /**
+      Optional callback called once after a batch of parameterChanged() calls.@n
+      Parameter changes are delivered together, at most once per frame as set by @ref DISTRHO_UI_FRAME_RATE,
+      so the UI can do any expensive updates (like a single repaint) here instead of on every change.
+    */
+    virtual void parameterChangesBatch() {}
+#endif
+
    /* --------------------------------------------------------------------------------------------------------
     * DSP/Plugin Callbacks (optional) */
 
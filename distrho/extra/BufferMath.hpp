@@ -0,0 +1,910 @@
+/*
+ * DISTRHO Plugin Framework (DPF)
+ * Copyright (C) 2012-2023 Filipe Coelho <falktx@falktx.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any purpose with
+ * or without fee is hereby granted, provided that the above copyright notice and this
+ * permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+ * TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+ * NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+ * IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef DISTRHO_BUFFER_MATH_HPP_INCLUDED
+#define DISTRHO_BUFFER_MATH_HPP_INCLUDED
+
+#include "../DistrhoUtils.hpp"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define DISTRHO_BUFFER_MATH_SSE2
+# include <emmintrin.h>
+# if (defined(__GNUC__) || defined(__clang__)) && ! defined(__EMSCRIPTEN__)
+#  define DISTRHO_BUFFER_MATH_AVX2
+#  define DISTRHO_BUFFER_MATH_AVX2_TARGET __attribute__((target("avx2")))
+#  include <cpuid.h>
+#  include <immintrin.h>
+# endif
+#elif (defined(__aarch64__) || defined(_M_ARM64)) && (defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64))
+# define DISTRHO_BUFFER_MATH_NEON
+# include <arm_neon.h>
+#endif
+
+// --------------------------------------------------------------------------------------------------------------------
+// Buffer math
+
+/**
+   Common buffer operations with SIMD implementations, picked at runtime based on CPU features.
+
+   All functions take unaligned buffers and any number of frames.
+   The SSE2, AVX2 and NEON implementations give bit-exact results compared to the scalar one,
+   as long as the input is finite and the compiler is not allowed to reorder or fuse floating-point operations
+   (that is, without -ffast-math and with -ffp-contract=off).
+
+   For example, a peak meter and a stereo gain ramp:
+   @code
+   const float peak = d_bufferPeak(inputs[0], frames);
+   d_bufferApplyGainRamp(outputs[0], oldGain, newGain, frames);
+   d_bufferApplyGainRamp(outputs[1], oldGain, newGain, frames);
+   @endcode
+ */
+enum BufferMathLevel {
+    kBufferMathScalar = 0,
+    kBufferMathSSE2,
+    kBufferMathAVX2,
+    kBufferMathNEON
+};
+
+/**
+   Scalar implementation, also used as reference for the SIMD ones.
+   RMS is accumulated over 8 interleaved lanes, so that all implementations sum in the same order.
+ */
+struct BufferMathScalar {
+    static void add(float* const dst, const float* const src, const uint32_t frames) noexcept
+    {
+        for (uint32_t i=0; i<frames; ++i)
+            dst[i] += src[i];
+    }
+
+    static void multiplyAdd(float* const dst, const float* const src, const float gain, const uint32_t frames) noexcept
+    {
+        for (uint32_t i=0; i<frames; ++i)
+            dst[i] += src[i] * gain;
+    }
+
+    static void applyGain(float* const buf, const float gain, const uint32_t frames) noexcept
+    {
+        for (uint32_t i=0; i<frames; ++i)
+            buf[i] *= gain;
+    }
+
+    static void applyGainRamp(float* const buf, const float start, const float step, const uint32_t frames) noexcept
+    {
+        for (uint32_t i=0; i<frames; ++i)
+            buf[i] *= start + step * static_cast<float>(i);
+    }
+
+    static float peak(const float* const src, const uint32_t frames) noexcept
+    {
+        float ret = 0.f;
+
+        for (uint32_t i=0; i<frames; ++i)
+        {
+            const float tmp = std::abs(src[i]);
+
+            if (tmp > ret)
+                ret = tmp;
+        }
+
+        return ret;
+    }
+
+    static float sumOfSquares(const float* const src, const uint32_t frames) noexcept
+    {
+        float acc[8] = { 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f };
+        uint32_t i = 0;
+
+        for (; i + 8 <= frames; i += 8)
+            for (uint32_t k=0; k<8; ++k)
+                acc[k] += src[i + k] * src[i + k];
+
+        return sumOfSquaresTail(acc, src, i, frames);
+    }
+
+    static void interleave(float* const dst, const float* const left, const float* const right, const uint32_t frames) noexcept
+    {
+        for (uint32_t i=0; i<frames; ++i)
+        {
+            dst[i * 2] = left[i];
+            dst[i * 2 + 1] = right[i];
+        }
+    }
+
+    static void deinterleave(float* const left, float* const right, const float* const src, const uint32_t frames) noexcept
+    {
+        for (uint32_t i=0; i<frames; ++i)
+        {
+            left[i] = src[i * 2];
+            right[i] = src[i * 2 + 1];
+        }
+    }
+
+    static void toInt16(int16_t* const dst, const float* const src, const uint32_t frames) noexcept
+    {
+        for (uint32_t i=0; i<frames; ++i)
+            dst[i] = static_cast<int16_t>(std::lrintf(clamp(src[i] * 32768.f, -32768.f, 32767.f)));
+    }
+
+    static void fromInt16(float* const dst, const int16_t* const src, const uint32_t frames) noexcept
+    {
+        for (uint32_t i=0; i<frames; ++i)
+            dst[i] = static_cast<float>(src[i]) * (1.f / 32768.f);
+    }
+
+    static void toInt32(int32_t* const dst, const float* const src, const uint32_t frames) noexcept
+    {
+        // 2147483520 is the biggest float value that still fits in int32
+        for (uint32_t i=0; i<frames; ++i)
+            dst[i] = static_cast<int32_t>(std::lrintf(clamp(src[i] * 2147483648.f, -2147483648.f, 2147483520.f)));
+    }
+
+    static void fromInt32(float* const dst, const int32_t* const src, const uint32_t frames) noexcept
+    {
+        for (uint32_t i=0; i<frames; ++i)
+            dst[i] = static_cast<float>(src[i]) * (1.f / 2147483648.f);
+    }
+
+    // shared by all implementations, fixed reduction order of the 8 accumulation lanes and then the remaining frames
+    static float sumOfSquaresTail(const float acc[8], const float* const src, uint32_t i, const uint32_t frames) noexcept
+    {
+        const float a0 = acc[0] + acc[4];
+        const float a1 = acc[1] + acc[5];
+        const float a2 = acc[2] + acc[6];
+        const float a3 = acc[3] + acc[7];
+        float ret = (a0 + a2) + (a1 + a3);
+
+        for (; i<frames; ++i)
+            ret += src[i] * src[i];
+
+        return ret;
+    }
+
+    static inline float clamp(const float value, const float min, const float max) noexcept
+    {
+        return value < min ? min : (value > max ? max : value);
+    }
+};
+
+#ifdef DISTRHO_BUFFER_MATH_SSE2
+/**
+   SSE2 implementation, always available on x86_64.
+ */
+struct BufferMathSSE2 {
+    static void add(float* const dst, const float* const src, const uint32_t frames) noexcept
+    {
+        uint32_t i = 0;
+        for (; i + 4 <= frames; i += 4)
+            _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+
+        BufferMathScalar::add(dst + i, src + i, frames - i);
+    }
+
+    static void multiplyAdd(float* const dst, const float* const src, const float gain, const uint32_t frames) noexcept
+    {
+        const __m128 g = _mm_set1_ps(gain);
+
+        uint32_t i = 0;
+        for (; i + 4 <= frames; i += 4)
+            _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), g)));
+
+        BufferMathScalar::multiplyAdd(dst + i, src + i, gain, frames - i);
+    }
+
+    static void applyGain(float* const buf, const float gain, const uint32_t frames) noexcept
+    {
+        const __m128 g = _mm_set1_ps(gain);
+
+        uint32_t i = 0;
+        for (; i + 4 <= frames; i += 4)
+            _mm_storeu_ps(buf + i, _mm_mul_ps(_mm_loadu_ps(buf + i), g));
+
+        BufferMathScalar::applyGain(buf + i, gain, frames - i);
+    }
+
+    static void applyGainRamp(float* const buf, const float start, const float step, const uint32_t frames) noexcept
+    {
+        const __m128 s = _mm_set1_ps(start);
+        const __m128 st = _mm_set1_ps(step);
+        const __m128 four = _mm_set1_ps(4.f);
+        __m128 idx = _mm_setr_ps(0.f, 1.f, 2.f, 3.f);
+
+        uint32_t i = 0;
+        for (; i + 4 <= frames; i += 4, idx = _mm_add_ps(idx, four))
+            _mm_storeu_ps(buf + i, _mm_mul_ps(_mm_loadu_ps(buf + i), _mm_add_ps(s, _mm_mul_ps(st, idx))));
+
+        for (; i<frames; ++i)
+            buf[i] *= start + step * static_cast<float>(i);
+    }
+
+    static float peak(const float* const src, const uint32_t frames) noexcept
+    {
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+        __m128 m = _mm_setzero_ps();
+
+        uint32_t i = 0;
+        for (; i + 4 <= frames; i += 4)
+            m = _mm_max_ps(m, _mm_and_ps(_mm_loadu_ps(src + i), absMask));
+
+        m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+        m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+
+        return std::max(_mm_cvtss_f32(m), BufferMathScalar::peak(src + i, frames - i));
+    }
+
+    static float sumOfSquares(const float* const src, const uint32_t frames) noexcept
+    {
+        __m128 acc0 = _mm_setzero_ps();
+        __m128 acc1 = _mm_setzero_ps();
+
+        uint32_t i = 0;
+        for (; i + 8 <= frames; i += 8)
+        {
+            const __m128 x0 = _mm_loadu_ps(src + i);
+            const __m128 x1 = _mm_loadu_ps(src + i + 4);
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(x0, x0));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(x1, x1));
+        }
+
+        float acc[8];
+        _mm_storeu_ps(acc, acc0);
+        _mm_storeu_ps(acc + 4, acc1);
+        return BufferMathScalar::sumOfSquaresTail(acc, src, i, frames);
+    }
+
+    static void interleave(float* const dst, const float* const left, const float* const right, const uint32_t frames) noexcept
+    {
+        uint32_t i = 0;
+        for (; i + 4 <= frames; i += 4)
+        {
+            const __m128 l = _mm_loadu_ps(left + i);
+            const __m128 r = _mm_loadu_ps(right + i);
+            _mm_storeu_ps(dst + i * 2, _mm_unpacklo_ps(l, r));
+            _mm_storeu_ps(dst + i * 2 + 4, _mm_unpackhi_ps(l, r));
+        }
+
+        BufferMathScalar::interleave(dst + i * 2, left + i, right + i, frames - i);
+    }
+
+    static void deinterleave(float* const left, float* const right, const float* const src, const uint32_t frames) noexcept
+    {
+        uint32_t i = 0;
+        for (; i + 4 <= frames; i += 4)
+        {
+            const __m128 x0 = _mm_loadu_ps(src + i * 2);
+            const __m128 x1 = _mm_loadu_ps(src + i * 2 + 4);
+            _mm_storeu_ps(left + i, _mm_shuffle_ps(x0, x1, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(right + i, _mm_shuffle_ps(x0, x1, _MM_SHUFFLE(3, 1, 3, 1)));
+        }
+
+        BufferMathScalar::deinterleave(left + i, right + i, src + i * 2, frames - i);
+    }
+
+    static void toInt16(int16_t* const dst, const float* const src, const uint32_t frames) noexcept
+    {
+        const __m128 scale = _mm_set1_ps(32768.f);
+        const __m128 min = _mm_set1_ps(-32768.f);
+        const __m128 max = _mm_set1_ps(32767.f);
+
+        uint32_t i = 0;
+        for (; i + 8 <= frames; i += 8)
+        {
+            const __m128 x0 = _mm_max_ps(_mm_min_ps(_mm_mul_ps(_mm_loadu_ps(src + i), scale), max), min);
+            const __m128 x1 = _mm_max_ps(_mm_min_ps(_mm_mul_ps(_mm_loadu_ps(src + i + 4), scale), max), min);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                             _mm_packs_epi32(_mm_cvtps_epi32(x0), _mm_cvtps_epi32(x1)));
+        }
+
+        BufferMathScalar::toInt16(dst + i, src + i, frames - i);
+    }
+
+    static void fromInt16(float* const dst, const int16_t* const src, const uint32_t frames) noexcept
+    {
+        const __m128 scale = _mm_set1_ps(1.f / 32768.f);
+
+        uint32_t i = 0;
+        for (; i + 8 <= frames; i += 8)
+        {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+            const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+            _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+            _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+        }
+
+        BufferMathScalar::fromInt16(dst + i, src + i, frames - i);
+    }
+
+    static void toInt32(int32_t* const dst, const float* const src, const uint32_t frames) noexcept
+    {
+        const __m128 scale = _mm_set1_ps(2147483648.f);
+        const __m128 min = _mm_set1_ps(-2147483648.f);
+        const __m128 max = _mm_set1_ps(2147483520.f);
+
+        uint32_t i = 0;
+        for (; i + 4 <= frames; i += 4)
+        {
+            const __m128 x = _mm_max_ps(_mm_min_ps(_mm_mul_ps(_mm_loadu_ps(src + i), scale), max), min);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_cvtps_epi32(x));
+        }
+
+        BufferMathScalar::toInt32(dst + i, src + i, frames - i);
+    }
+
+    static void fromInt32(float* const dst, const int32_t* const src, const uint32_t frames) noexcept
+    {
+        const __m128 scale = _mm_set1_ps(1.f / 2147483648.f);
+
+        uint32_t i = 0;
+        for (; i + 4 <= frames; i += 4)
+        {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(x), scale));
+        }
+
+        BufferMathScalar::fromInt32(dst + i, src + i, frames - i);
+    }
+};
+#endif // DISTRHO_BUFFER_MATH_SSE2
+
+#ifdef DISTRHO_BUFFER_MATH_AVX2
+/**
+   AVX2 implementation, only used if the running CPU supports it.
+   Compiled through a target attribute, so it does not require building the whole plugin with -mavx2.
+ */
+struct BufferMathAVX2 {
+    DISTRHO_BUFFER_MATH_AVX2_TARGET
+    static void add(float* const dst, const float* const src, const uint32_t frames) noexcept
+    {
+        uint32_t i = 0;
+        for (; i + 8 <= frames; i += 8)
+            _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_loadu_ps(src + i)));
+
+        BufferMathSSE2::add(dst + i, src + i, frames - i);
+    }
+
+    DISTRHO_BUFFER_MATH_AVX2_TARGET
+    static void multiplyAdd(float* const dst, const float* const src, const float gain, const uint32_t frames) noexcept
+    {
+        const __m256 g = _mm256_set1_ps(gain);
+
+        uint32_t i = 0;
+        for (; i + 8 <= frames; i += 8)
+            _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), g)));
+
+        BufferMathSSE2::multiplyAdd(dst + i, src + i, gain, frames - i);
+    }
+
+    DISTRHO_BUFFER_MATH_AVX2_TARGET
+    static void applyGain(float* const buf, const float gain, const uint32_t frames) noexcept
+    {
+        const __m256 g = _mm256_set1_ps(gain);
+
+        uint32_t i = 0;
+        for (; i + 8 <= frames; i += 8)
+            _mm256_storeu_ps(buf + i, _mm256_mul_ps(_mm256_loadu_ps(buf + i), g));
+
+        BufferMathSSE2::applyGain(buf + i, gain, frames - i);
+    }
+
+    DISTRHO_BUFFER_MATH_AVX2_TARGET
+    static void applyGainRamp(float* const buf, const float start, const float step, const uint32_t frames) noexcept
+    {
+        const __m256 s = _mm256_set1_ps(start);
+        const __m256 st = _mm256_set1_ps(step);
+        const __m256 eight = _mm256_set1_ps(8.f);
+        __m256 idx = _mm256_setr_ps(0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f);
+
+        uint32_t i = 0;
+        for (; i + 8 <= frames; i += 8, idx = _mm256_add_ps(idx, eight))
+            _mm256_storeu_ps(buf + i, _mm256_mul_ps(_mm256_loadu_ps(buf + i), _mm256_add_ps(s, _mm256_mul_ps(st, idx))));
+
+        for (; i<frames; ++i)
+            buf[i] *= start + step * static_cast<float>(i);
+    }
+
+    DISTRHO_BUFFER_MATH_AVX2_TARGET
+    static float peak(const float* const src, const uint32_t frames) noexcept
+    {
+        const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+        __m256 m = _mm256_setzero_ps();
+
+        uint32_t i = 0;
+        for (; i + 8 <= frames; i += 8)
+            m = _mm256_max_ps(m, _mm256_and_ps(_mm256_loadu_ps(src + i), absMask));
+
+        __m128 m4 = _mm_max_ps(_mm256_castps256_ps128(m), _mm256_extractf128_ps(m, 1));
+        m4 = _mm_max_ps(m4, _mm_movehl_ps(m4, m4));
+        m4 = _mm_max_ss(m4, _mm_shuffle_ps(m4, m4, 1));
+
+        return std::max(_mm_cvtss_f32(m4), BufferMathScalar::peak(src + i, frames - i));
+    }
+
+    DISTRHO_BUFFER_MATH_AVX2_TARGET
+    static float sumOfSquares(const float* const src, const uint32_t frames) noexcept
+    {
+        __m256 acc = _mm256_setzero_ps();
+
+        uint32_t i = 0;
+        for (; i + 8 <= frames; i += 8)
+        {
+            const __m256 x = _mm256_loadu_ps(src + i);
+            acc = _mm256_add_ps(acc, _mm256_mul_ps(x, x));
+        }
+
+        float tmp[8];
+        _mm256_storeu_ps(tmp, acc);
+        return BufferMathScalar::sumOfSquaresTail(tmp, src, i, frames);
+    }
+
+    DISTRHO_BUFFER_MATH_AVX2_TARGET
+    static void interleave(float* const dst, const float* const left, const float* const right, const uint32_t frames) noexcept
+    {
+        uint32_t i = 0;
+        for (; i + 8 <= frames; i += 8)
+        {
+            const __m256 l = _mm256_loadu_ps(left + i);
+            const __m256 r = _mm256_loadu_ps(right + i);
+            const __m256 lo = _mm256_unpacklo_ps(l, r);
+            const __m256 hi = _mm256_unpackhi_ps(l, r);
+            _mm256_storeu_ps(dst + i * 2, _mm256_permute2f128_ps(lo, hi, 0x20));
+            _mm256_storeu_ps(dst + i * 2 + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+        }
+
+        BufferMathSSE2::interleave(dst + i * 2, left + i, right + i, frames - i);
+    }
+
+    DISTRHO_BUFFER_MATH_AVX2_TARGET
+    static void deinterleave(float* const left, float* const right, const float* const src, const uint32_t frames) noexcept
+    {
+        uint32_t i = 0;
+        for (; i + 8 <= frames; i += 8)
+        {
+            const __m256 x0 = _mm256_loadu_ps(src + i * 2);
+            const __m256 x1 = _mm256_loadu_ps(src + i * 2 + 8);
+            const __m256d l = _mm256_castps_pd(_mm256_shuffle_ps(x0, x1, _MM_SHUFFLE(2, 0, 2, 0)));
+            const __m256d r = _mm256_castps_pd(_mm256_shuffle_ps(x0, x1, _MM_SHUFFLE(3, 1, 3, 1)));
+            _mm256_storeu_ps(left + i, _mm256_castpd_ps(_mm256_permute4x64_pd(l, _MM_SHUFFLE(3, 1, 2, 0))));
+            _mm256_storeu_ps(right + i, _mm256_castpd_ps(_mm256_permute4x64_pd(r, _MM_SHUFFLE(3, 1, 2, 0))));
+        }
+
+        BufferMathSSE2::deinterleave(left + i, right + i, src + i * 2, frames - i);
+    }
+
+    DISTRHO_BUFFER_MATH_AVX2_TARGET
+    static void toInt16(int16_t* const dst, const float* const src, const uint32_t frames) noexcept
+    {
+        const __m256 scale = _mm256_set1_ps(32768.f);
+        const __m256 min = _mm256_set1_ps(-32768.f);
+        const __m256 max = _mm256_set1_ps(32767.f);
+
+        uint32_t i = 0;
+        for (; i + 8 <= frames; i += 8)
+        {
+            const __m256 x = _mm256_max_ps(_mm256_min_ps(_mm256_mul_ps(_mm256_loadu_ps(src + i), scale), max), min);
+            const __m256i v = _mm256_cvtps_epi32(x);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                             _mm_packs_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+        }
+
+        BufferMathScalar::toInt16(dst + i, src + i, frames - i);
+    }
+
+    DISTRHO_BUFFER_MATH_AVX2_TARGET
+    static void fromInt16(float* const dst, const int16_t* const src, const uint32_t frames) noexcept
+    {
+        const __m256 scale = _mm256_set1_ps(1.f / 32768.f);
+
+        uint32_t i = 0;
+        for (; i + 8 <= frames; i += 8)
+        {
+            const __m256i x = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+            _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(x), scale));
+        }
+
+        BufferMathScalar::fromInt16(dst + i, src + i, frames - i);
+    }
+
+    DISTRHO_BUFFER_MATH_AVX2_TARGET
+    static void toInt32(int32_t* const dst, const float* const src, const uint32_t frames) noexcept
+    {
+        const __m256 scale = _mm256_set1_ps(2147483648.f);
+        const __m256 min = _mm256_set1_ps(-2147483648.f);
+        const __m256 max = _mm256_set1_ps(2147483520.f);
+
+        uint32_t i = 0;
+        for (; i + 8 <= frames; i += 8)
+        {
+            const __m256 x = _mm256_max_ps(_mm256_min_ps(_mm256_mul_ps(_mm256_loadu_ps(src + i), scale), max), min);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_cvtps_epi32(x));
+        }
+
+        BufferMathSSE2::toInt32(dst + i, src + i, frames - i);
+    }
+
+    DISTRHO_BUFFER_MATH_AVX2_TARGET
+    static void fromInt32(float* const dst, const int32_t* const src, const uint32_t frames) noexcept
+    {
+        const __m256 scale = _mm256_set1_ps(1.f / 2147483648.f);
+
+        uint32_t i = 0;
+        for (; i + 8 <= frames; i += 8)
+        {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(x), scale));
+        }
+
+        BufferMathSSE2::fromInt32(dst + i, src + i, frames - i);
+    }
+
+    static bool isSupported() noexcept
+    {
+        uint32_t eax, ebx, ecx, edx;
+
+        // AVX and OSXSAVE
+        if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0)
+            return false;
+        if ((ecx & (1u << 27)) == 0 || (ecx & (1u << 28)) == 0)
+            return false;
+
+        // OS must save the full YMM registers on context switch
+        uint32_t xcr0, xcr0hi;
+        __asm__ __volatile__("xgetbv" : "=a" (xcr0), "=d" (xcr0hi) : "c" (0));
+        if ((xcr0 & 0x6) != 0x6)
+            return false;
+
+        // AVX2
+        if (__get_cpuid_max(0, nullptr) < 7)
+            return false;
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+        return (ebx & (1u << 5)) != 0;
+    }
+};
+#endif // DISTRHO_BUFFER_MATH_AVX2
+
+#ifdef DISTRHO_BUFFER_MATH_NEON
+/**
+   NEON implementation, always available on aarch64.
+ */
+struct BufferMathNEON {
+    static void add(float* const dst, const float* const src, const uint32_t frames) noexcept
+    {
+        uint32_t i = 0;
+        for (; i + 4 <= frames; i += 4)
+            vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), vld1q_f32(src + i)));
+
+        BufferMathScalar::add(dst + i, src + i, frames - i);
+    }
+
+    static void multiplyAdd(float* const dst, const float* const src, const float gain, const uint32_t frames) noexcept
+    {
+        const float32x4_t g = vdupq_n_f32(gain);
+
+        // vmulq + vaddq instead of vmlaq, the later may be fused and not match the scalar results
+        uint32_t i = 0;
+        for (; i + 4 <= frames; i += 4)
+            vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), vmulq_f32(vld1q_f32(src + i), g)));
+
+        BufferMathScalar::multiplyAdd(dst + i, src + i, gain, frames - i);
+    }
+
+    static void applyGain(float* const buf, const float gain, const uint32_t frames) noexcept
+    {
+        const float32x4_t g = vdupq_n_f32(gain);
+
+        uint32_t i = 0;
+        for (; i + 4 <= frames; i += 4)
+            vst1q_f32(buf + i, vmulq_f32(vld1q_f32(buf + i), g));
+
+        BufferMathScalar::applyGain(buf + i, gain, frames - i);
+    }
+
+    static void applyGainRamp(float* const buf, const float start, const float step, const uint32_t frames) noexcept
+    {
+        static const float kIndexes[4] = { 0.f, 1.f, 2.f, 3.f };
+        const float32x4_t s = vdupq_n_f32(start);
+        const float32x4_t st = vdupq_n_f32(step);
+        const float32x4_t four = vdupq_n_f32(4.f);
+        float32x4_t idx = vld1q_f32(kIndexes);
+
+        uint32_t i = 0;
+        for (; i + 4 <= frames; i += 4, idx = vaddq_f32(idx, four))
+            vst1q_f32(buf + i, vmulq_f32(vld1q_f32(buf + i), vaddq_f32(s, vmulq_f32(st, idx))));
+
+        for (; i<frames; ++i)
+            buf[i] *= start + step * static_cast<float>(i);
+    }
+
+    static float peak(const float* const src, const uint32_t frames) noexcept
+    {
+        float32x4_t m = vdupq_n_f32(0.f);
+
+        uint32_t i = 0;
+        for (; i + 4 <= frames; i += 4)
+            m = vmaxq_f32(m, vabsq_f32(vld1q_f32(src + i)));
+
+        return std::max(vmaxvq_f32(m), BufferMathScalar::peak(src + i, frames - i));
+    }
+
+    static float sumOfSquares(const float* const src, const uint32_t frames) noexcept
+    {
+        float32x4_t acc0 = vdupq_n_f32(0.f);
+        float32x4_t acc1 = vdupq_n_f32(0.f);
+
+        uint32_t i = 0;
+        for (; i + 8 <= frames; i += 8)
+        {
+            const float32x4_t x0 = vld1q_f32(src + i);
+            const float32x4_t x1 = vld1q_f32(src + i + 4);
+            acc0 = vaddq_f32(acc0, vmulq_f32(x0, x0));
+            acc1 = vaddq_f32(acc1, vmulq_f32(x1, x1));
+        }
+
+        float acc[8];
+        vst1q_f32(acc, acc0);
+        vst1q_f32(acc + 4, acc1);
+        return BufferMathScalar::sumOfSquaresTail(acc, src, i, frames);
+    }
+
+    static void interleave(float* const dst, const float* const left, const float* const right, const uint32_t frames) noexcept
+    {
+        uint32_t i = 0;
+        for (; i + 4 <= frames; i += 4)
+        {
+            float32x4x2_t x;
+            x.val[0] = vld1q_f32(left + i);
+            x.val[1] = vld1q_f32(right + i);
+            vst2q_f32(dst + i * 2, x);
+        }
+
+        BufferMathScalar::interleave(dst + i * 2, left + i, right + i, frames - i);
+    }
+
+    static void deinterleave(float* const left, float* const right, const float* const src, const uint32_t frames) noexcept
+    {
+        uint32_t i = 0;
+        for (; i + 4 <= frames; i += 4)
+        {
+            const float32x4x2_t x = vld2q_f32(src + i * 2);
+            vst1q_f32(left + i, x.val[0]);
+            vst1q_f32(right + i, x.val[1]);
+        }
+
+        BufferMathScalar::deinterleave(left + i, right + i, src + i * 2, frames - i);
+    }
+
+    static void toInt16(int16_t* const dst, const float* const src, const uint32_t frames) noexcept
+    {
+        const float32x4_t scale = vdupq_n_f32(32768.f);
+        const float32x4_t min = vdupq_n_f32(-32768.f);
+        const float32x4_t max = vdupq_n_f32(32767.f);
+
+        uint32_t i = 0;
+        for (; i + 8 <= frames; i += 8)
+        {
+            const float32x4_t x0 = vmaxq_f32(vminq_f32(vmulq_f32(vld1q_f32(src + i), scale), max), min);
+            const float32x4_t x1 = vmaxq_f32(vminq_f32(vmulq_f32(vld1q_f32(src + i + 4), scale), max), min);
+            vst1q_s16(dst + i, vcombine_s16(vqmovn_s32(vcvtnq_s32_f32(x0)), vqmovn_s32(vcvtnq_s32_f32(x1))));
+        }
+
+        BufferMathScalar::toInt16(dst + i, src + i, frames - i);
+    }
+
+    static void fromInt16(float* const dst, const int16_t* const src, const uint32_t frames) noexcept
+    {
+        const float32x4_t scale = vdupq_n_f32(1.f / 32768.f);
+
+        uint32_t i = 0;
+        for (; i + 8 <= frames; i += 8)
+        {
+            const int16x8_t x = vld1q_s16(src + i);
+            vst1q_f32(dst + i, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(x))), scale));
+            vst1q_f32(dst + i + 4, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(x))), scale));
+        }
+
+        BufferMathScalar::fromInt16(dst + i, src + i, frames - i);
+    }
+
+    static void toInt32(int32_t* const dst, const float* const src, const uint32_t frames) noexcept
+    {
+        const float32x4_t scale = vdupq_n_f32(2147483648.f);
+        const float32x4_t min = vdupq_n_f32(-2147483648.f);
+        const float32x4_t max = vdupq_n_f32(2147483520.f);
+
+        uint32_t i = 0;
+        for (; i + 4 <= frames; i += 4)
+        {
+            const float32x4_t x = vmaxq_f32(vminq_f32(vmulq_f32(vld1q_f32(src + i), scale), max), min);
+            vst1q_s32(dst + i, vcvtnq_s32_f32(x));
+        }
+
+        BufferMathScalar::toInt32(dst + i, src + i, frames - i);
+    }
+
+    static void fromInt32(float* const dst, const int32_t* const src, const uint32_t frames) noexcept
+    {
+        const float32x4_t scale = vdupq_n_f32(1.f / 2147483648.f);
+
+        uint32_t i = 0;
+        for (; i + 4 <= frames; i += 4)
+            vst1q_f32(dst + i, vmulq_f32(vcvtq_f32_s32(vld1q_s32(src + i)), scale));
+
+        BufferMathScalar::fromInt32(dst + i, src + i, frames - i);
+    }
+};
+#endif // DISTRHO_BUFFER_MATH_NEON
+
+// --------------------------------------------------------------------------------------------------------------------
+// Runtime dispatch
+
+/**
+   Get the best implementation supported by the running CPU.
+   Detection happens only once, on the first call.
+ */
+static inline
+BufferMathLevel d_getBufferMathLevel() noexcept
+{
+   #if defined(DISTRHO_BUFFER_MATH_AVX2)
+    static const BufferMathLevel level = BufferMathAVX2::isSupported() ? kBufferMathAVX2 : kBufferMathSSE2;
+    return level;
+   #elif defined(DISTRHO_BUFFER_MATH_SSE2)
+    return kBufferMathSSE2;
+   #elif defined(DISTRHO_BUFFER_MATH_NEON)
+    return kBufferMathNEON;
+   #else
+    return kBufferMathScalar;
+   #endif
+}
+
+#if defined(DISTRHO_BUFFER_MATH_AVX2)
+# define DISTRHO_BUFFER_MATH_DISPATCH(RET, FN, ARGS)              \
+    if (d_getBufferMathLevel() == kBufferMathAVX2)                \
+        RET BufferMathAVX2::FN ARGS;                              \
+    else                                                          \
+        RET BufferMathSSE2::FN ARGS;
+#elif defined(DISTRHO_BUFFER_MATH_SSE2)
+# define DISTRHO_BUFFER_MATH_DISPATCH(RET, FN, ARGS) RET BufferMathSSE2::FN ARGS;
+#elif defined(DISTRHO_BUFFER_MATH_NEON)
+# define DISTRHO_BUFFER_MATH_DISPATCH(RET, FN, ARGS) RET BufferMathNEON::FN ARGS;
+#else
+# define DISTRHO_BUFFER_MATH_DISPATCH(RET, FN, ARGS) RET BufferMathScalar::FN ARGS;
+#endif
+
+/**
+   Add @a src into @a dst.
+ */
+static inline
+void d_bufferAdd(float* const dst, const float* const src, const uint32_t frames) noexcept
+{
+    DISTRHO_BUFFER_MATH_DISPATCH(return, add, (dst, src, frames))
+}
+
+/**
+   Add @a src multiplied by @a gain into @a dst.
+ */
+static inline
+void d_bufferMultiplyAdd(float* const dst, const float* const src, const float gain, const uint32_t frames) noexcept
+{
+    DISTRHO_BUFFER_MATH_DISPATCH(return, multiplyAdd, (dst, src, gain, frames))
+}
+
+/**
+   Multiply @a buf by a constant @a gain.
+ */
+static inline
+void d_bufferApplyGain(float* const buf, const float gain, const uint32_t frames) noexcept
+{
+    DISTRHO_BUFFER_MATH_DISPATCH(return, applyGain, (buf, gain, frames))
+}
+
+/**
+   Multiply @a buf by a linear gain ramp, going from @a startGain towards @a endGain.
+   The last frame gets one step short of @a endGain, so that a following block starting at @a endGain is continuous.
+ */
+static inline
+void d_bufferApplyGainRamp(float* const buf, const float startGain, const float endGain, const uint32_t frames) noexcept
+{
+    DISTRHO_SAFE_ASSERT_RETURN(frames != 0,);
+
+    if (d_isEqual(startGain, endGain))
+        return d_bufferApplyGain(buf, startGain, frames);
+
+    const float step = (endGain - startGain) / static_cast<float>(frames);
+    DISTRHO_BUFFER_MATH_DISPATCH(return, applyGainRamp, (buf, startGain, step, frames))
+}
+
+/**
+   Get the absolute peak value of @a src.
+ */
+static inline
+float d_bufferPeak(const float* const src, const uint32_t frames) noexcept
+{
+    DISTRHO_BUFFER_MATH_DISPATCH(return, peak, (src, frames))
+}
+
+/**
+   Get the RMS value of @a src.
+ */
+static inline
+float d_bufferRMS(const float* const src, const uint32_t frames) noexcept
+{
+    DISTRHO_SAFE_ASSERT_RETURN(frames != 0, 0.f);
+
+    float sum;
+    DISTRHO_BUFFER_MATH_DISPATCH(sum =, sumOfSquares, (src, frames))
+    return std::sqrt(sum / static_cast<float>(frames));
+}
+
+/**
+   Interleave 2 channels into @a dst, which must have room for 2 * @a frames values.
+ */
+static inline
+void d_bufferInterleave(float* const dst, const float* const left, const float* const right, const uint32_t frames) noexcept
+{
+    DISTRHO_BUFFER_MATH_DISPATCH(return, interleave, (dst, left, right, frames))
+}
+
+/**
+   Deinterleave 2 channels from @a src, which must contain 2 * @a frames values.
+ */
+static inline
+void d_bufferDeinterleave(float* const left, float* const right, const float* const src, const uint32_t frames) noexcept
+{
+    DISTRHO_BUFFER_MATH_DISPATCH(return, deinterleave, (left, right, src, frames))
+}
+
+/**
+   Convert float samples into clipped signed 16-bit integers, rounding to nearest.
+ */
+static inline
+void d_bufferToInt16(int16_t* const dst, const float* const src, const uint32_t frames) noexcept
+{
+    DISTRHO_BUFFER_MATH_DISPATCH(return, toInt16, (dst, src, frames))
+}
+
+/**
+   Convert signed 16-bit integers into float samples.
+ */
+static inline
+void d_bufferFromInt16(float* const dst, const int16_t* const src, const uint32_t frames) noexcept
+{
+    DISTRHO_BUFFER_MATH_DISPATCH(return, fromInt16, (dst, src, frames))
+}
+
+/**
+   Convert float samples into clipped signed 32-bit integers, rounding to nearest.
+ */
+static inline
+void d_bufferToInt32(int32_t* const dst, const float* const src, const uint32_t frames) noexcept
+{
+    DISTRHO_BUFFER_MATH_DISPATCH(return, toInt32, (dst, src, frames))
+}
+
+/**
+   Convert signed 32-bit integers into float samples.
+ */
+static inline
+void d_bufferFromInt32(float* const dst, const int32_t* const src, const uint32_t frames) noexcept
+{
+    DISTRHO_BUFFER_MATH_DISPATCH(return, fromInt32, (dst, src, frames))
+}
+
+#undef DISTRHO_BUFFER_MATH_DISPATCH
+
+// --------------------------------------------------------------------------------------------------------------------
+
+#endif // DISTRHO_BUFFER_MATH_HPP_INCLUDED
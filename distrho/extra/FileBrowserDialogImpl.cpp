@@ -776,6 +776,9 @@ bool fileBrowserIdle(const FileBrowserHandle handle)
     if (x11display == nullptr)
         return false;
 
+    // add directory entries read in the background
+    x_fib_idle(x11display);
+
     XEvent event;
     while (XPending(x11display) > 0)
     {
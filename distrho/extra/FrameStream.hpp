@@ -0,0 +1,297 @@
+/*
+ * DISTRHO Plugin Framework (DPF)
+ * Copyright (C) 2012-2023 Filipe Coelho <falktx@falktx.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any purpose with
+ * or without fee is hereby granted, provided that the above copyright notice and this
+ * permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+ * TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+ * NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+ * IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef DISTRHO_FRAME_STREAM_HPP_INCLUDED
+#define DISTRHO_FRAME_STREAM_HPP_INCLUDED
+
+#include "RingBuffer.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+// --------------------------------------------------------------------------------------------------------------------
+// FrameStream class
+
+/**
+   Single-producer single-consumer stream of fixed-size float frames, meant for sending DSP data to the UI.
+   Typical uses are oscilloscope waveforms and spectrum analyzer frames,
+   which do not fit in output parameters.
+
+   The DSP side writes audio blocks of any size with write(), which get split into frames of the size given in init().
+   Only complete frames are ever visible to the UI side, and the DSP side never blocks.
+   When the UI is not reading fast enough (or not open at all) the oldest frames are overwritten,
+   so the latest frame always wins.
+   setDecimation() can be used to keep only 1 of every N frames, reducing the work done on both sides.
+
+   The UI side drains the stream during uiIdle() with readLatestFrame() or readFrames().
+   Older frames are skipped when more are available than requested, so the UI always shows the latest data.
+
+   The stream lives in the plugin instance, so it requires the plugin and UI to run in the same process.
+   The UI gets to it through UI::getPluginInstancePointer(), which needs DISTRHO_PLUGIN_WANT_DIRECT_ACCESS enabled.
+
+   Example usage:
+   @code
+   // plugin side, init() must be called outside of the audio thread
+   plugin->scope.init(1024, 8);
+
+   void plugin_run(void* ptr, const float** inputs, float** outputs, uint32_t frames)
+   {
+       MyPlugin* plugin = (MyPlugin*)ptr;
+       plugin->scope.write(inputs[0], frames);
+   }
+
+   // UI side
+   void uiIdle() override
+   {
+       MyPlugin* const plugin = (MyPlugin*)getPluginInstancePointer();
+
+       if (plugin->scope.readLatestFrame(fScopeFrame))
+           repaint();
+   }
+   @endcode
+ */
+class FrameStream
+{
+public:
+    /*
+     * Constructor.
+     * A call to init() is required before the stream becomes usable.
+     */
+    FrameStream() noexcept
+        : slots(nullptr),
+          slotTags(nullptr),
+          slotMask(0),
+          maxFrames(0),
+          frameSize(0),
+          decimation(1),
+          writeCount(0),
+          frameCounter(0),
+          writePos(0),
+          skipFrame(false),
+          readCount(0) {}
+
+    /*
+     * Destructor.
+     */
+    ~FrameStream() noexcept
+    {
+        delete[] slots;
+        delete[] slotTags;
+    }
+
+    /*
+     * Allocate the stream for frames of @a newFrameSize values, holding up to @a maxQueuedFrames frames.
+     * Must not be called while any of the read or write functions are in use.
+     */
+    bool init(const uint32_t newFrameSize, const uint32_t maxQueuedFrames) noexcept
+    {
+        DISTRHO_SAFE_ASSERT_RETURN(newFrameSize != 0, false);
+        DISTRHO_SAFE_ASSERT_RETURN(maxQueuedFrames != 0, false);
+
+        delete[] slots;
+        delete[] slotTags;
+        slots = nullptr;
+        slotTags = nullptr;
+        slotMask = maxFrames = 0;
+        frameSize = 0;
+
+        // one extra slot for the frame being written, power of 2 so slot indexes survive frame counter wrap-around
+        const uint32_t numSlots = d_nextPowerOf2(maxQueuedFrames + 1);
+
+        try {
+            slots = new float[numSlots * newFrameSize];
+            slotTags = new uint32_t[numSlots];
+        } DISTRHO_SAFE_EXCEPTION_RETURN("FrameStream::init", false);
+
+        std::memset(slotTags, 0, sizeof(uint32_t) * numSlots);
+
+        slotMask = numSlots - 1;
+        maxFrames = maxQueuedFrames;
+        frameSize = newFrameSize;
+        writeCount = frameCounter = writePos = readCount = 0;
+        skipFrame = false;
+        return true;
+    }
+
+    /*
+     * Get the number of values per frame, as passed in init().
+     */
+    uint32_t getFrameSize() const noexcept
+    {
+        return frameSize;
+    }
+
+    /*
+     * Keep only 1 of every @a newDecimation frames, dropping the others on the DSP side.
+     * Must be called from the DSP side or while the stream is not in use.
+     */
+    void setDecimation(const uint32_t newDecimation) noexcept
+    {
+        DISTRHO_SAFE_ASSERT_RETURN(newDecimation != 0,);
+
+        decimation = newDecimation;
+    }
+
+    // ----------------------------------------------------------------------------------------------------------------
+    // DSP side, realtime safe
+
+    /*
+     * Write @a count values into the stream.
+     * Values are accumulated until a full frame is ready, which is then made visible to the UI side.
+     * Frames are dropped when decimated, and overwrite the oldest ones if the UI side is not reading fast enough.
+     */
+    void write(const float* values, uint32_t count) noexcept
+    {
+        DISTRHO_SAFE_ASSERT_RETURN(frameSize != 0,);
+
+        while (count != 0)
+        {
+            uint32_t& tag(slotTags[writeCount & slotMask]);
+            float* const slot = slots + (writeCount & slotMask) * frameSize;
+
+            // starting a new frame, decide if it is going to be kept
+            if (writePos == 0)
+            {
+                skipFrame = (frameCounter++ % decimation) != 0;
+
+                // odd tag while writing, so the UI side knows not to trust the slot contents
+                if (! skipFrame)
+                {
+                    d_ringBufferStoreRelease(tag, writeCount * 2 + 1);
+                    std::atomic_thread_fence(std::memory_order_release);
+                }
+            }
+
+            const uint32_t todo = std::min(count, frameSize - writePos);
+
+            if (! skipFrame)
+                std::memcpy(slot + writePos, values, sizeof(float) * todo);
+
+            values += todo;
+            count -= todo;
+            writePos += todo;
+
+            if (writePos == frameSize)
+            {
+                writePos = 0;
+
+                if (! skipFrame)
+                {
+                    d_ringBufferStoreRelease(tag, writeCount * 2 + 2);
+                    d_ringBufferStoreRelease(writeCount, writeCount + 1);
+                }
+            }
+        }
+    }
+
+    /*
+     * Write a full frame of values into the stream, as passed to init().
+     * This is the same as write(frame, getFrameSize()), meant for things like FFT frames.
+     * Should not be mixed with write() calls of other sizes, as frames would then no longer line up.
+     */
+    void writeFrame(const float* const frame) noexcept
+    {
+        write(frame, frameSize);
+    }
+
+    // ----------------------------------------------------------------------------------------------------------------
+    // UI side
+
+    /*
+     * Get the number of complete frames available for reading.
+     */
+    uint32_t getNumAvailableFrames() const noexcept
+    {
+        return std::min(d_ringBufferLoadAcquire(writeCount) - readCount, maxFrames);
+    }
+
+    /*
+     * Drain the stream and copy the most recent frame into @a frame.
+     * Returns false if there were no new frames, in which case @a frame is left untouched.
+     */
+    bool readLatestFrame(float* const frame) noexcept
+    {
+        return readFrames(frame, 1) != 0;
+    }
+
+    /*
+     * Drain the stream and copy the most recent frames into @a frames, oldest first.
+     * @a frames must have room for @a maxFramesToRead * getFrameSize() values.
+     * Returns the number of frames copied, older frames beyond @a maxFramesToRead are skipped.
+     */
+    uint32_t readFrames(float* const frames, const uint32_t maxFramesToRead) noexcept
+    {
+        DISTRHO_SAFE_ASSERT_RETURN(maxFramesToRead != 0, 0);
+
+        const uint32_t written = d_ringBufferLoadAcquire(writeCount);
+        const uint32_t available = std::min(written - readCount, maxFrames);
+
+        readCount = written;
+
+        if (available == 0)
+            return 0;
+
+        const uint32_t numFrames = std::min(available, maxFramesToRead);
+        uint32_t copied = 0;
+
+        for (uint32_t frame = written - numFrames; frame != written; ++frame)
+        {
+            const uint32_t& tag(slotTags[frame & slotMask]);
+            const uint32_t expectedTag = frame * 2 + 2;
+
+            if (d_ringBufferLoadAcquire(tag) != expectedTag)
+                continue;
+
+            std::memcpy(frames + copied * frameSize, slots + (frame & slotMask) * frameSize, sizeof(float) * frameSize);
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            // overwritten by a newer frame while copying, which will be read next time
+            if (d_ringBufferLoadAcquire(tag) != expectedTag)
+                continue;
+
+            ++copied;
+        }
+
+        return copied;
+    }
+
+private:
+    // frame slots, written round-robin and tagged with the frame number they hold
+    float* slots;
+    uint32_t* slotTags;
+    uint32_t slotMask;
+    uint32_t maxFrames;
+
+    uint32_t frameSize;
+    uint32_t decimation;
+
+    // number of complete frames written, shared with the UI side
+    uint32_t writeCount;
+
+    // DSP side state
+    uint32_t frameCounter;
+    uint32_t writePos;
+    bool skipFrame;
+
+    // UI side state
+    uint32_t readCount;
+
+    DISTRHO_DECLARE_NON_COPYABLE(FrameStream)
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+#endif // DISTRHO_FRAME_STREAM_HPP_INCLUDED
@@ -72,7 +72,7 @@ public:
        #endif
     }
 
-    bool lock() noexcept
+    bool lock() const noexcept
     {
        #ifdef DISTRHO_OS_WINDOWS__TODO
         EnterCriticalSection(&fSection);
@@ -82,7 +82,7 @@ public:
        #endif
     }
 
-    bool tryLock() noexcept
+    bool tryLock() const noexcept
     {
        #ifdef DISTRHO_OS_WINDOWS__TODO
         return (TryEnterCriticalSection(&fSection) != FALSE);
@@ -91,7 +91,7 @@ public:
        #endif
     }
 
-    void unlock() noexcept
+    void unlock() const noexcept
     {
        #ifdef DISTRHO_OS_WINDOWS__TODO
         LeaveCriticalSection(&fSection);
@@ -102,7 +102,7 @@ public:
 
 private:
    #ifdef DISTRHO_OS_WINDOWS__TODO
-    CRITICAL_SECTION fSection;
+    mutable CRITICAL_SECTION fSection;
    #else
     mutable pthread_mutex_t fMutex;
    #endif
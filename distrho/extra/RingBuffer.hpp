@@ -19,6 +19,9 @@
 
 #include "../DistrhoUtils.hpp"
 
+#if ! (defined(__GNUC__) || defined(__clang__))
+# include <atomic>
+#endif
 
 // -----------------------------------------------------------------------
 // Buffer structs
@@ -118,14 +121,75 @@ struct HugeStackBuffer {
     uint8_t  buf[size];
 };
 
+/**
+   RingBufferControl compatible struct with the same data as HeapBuffer,
+   but with producer and consumer positions placed in separate cache lines.
+
+   With HeapBuffer, @a head, @a tail and @a wrtn share the same cache line,
+   so every write on one side invalidates the cache of the other side (false sharing).
+   This layout avoids that at the cost of a few hundred bytes, which is worth it for high-throughput streams
+   where reading and writing happen at the same time in different threads.
+   @see HeapBuffer
+*/
+struct PaddedHeapBuffer {
+    uint32_t size;
+    uint8_t* buf;
+    uint8_t  pad1[64];
+
+    // producer side
+    uint32_t head, wrtn;
+    bool     invalidateCommit;
+    uint8_t  pad2[64];
+
+    // consumer side
+    uint32_t tail;
+    uint8_t  pad3[64];
+};
+
 #ifdef DISTRHO_PROPER_CPP11_SUPPORT
 # define HeapBuffer_INIT  {0, 0, 0, 0, false, nullptr}
+# define PaddedHeapBuffer_INIT {0, nullptr, {0}, 0, 0, false, {0}, 0, {0}}
 # define StackBuffer_INIT {0, 0, 0, false, {0}}
 #else
 # define HeapBuffer_INIT
+# define PaddedHeapBuffer_INIT
 # define StackBuffer_INIT
 #endif
 
+// -----------------------------------------------------------------------
+// Position access between threads
+
+/*
+ * Load a ring buffer position written by the other side.
+ * Acquire semantics, so data written before the matching store is visible after this call.
+ */
+static inline
+uint32_t d_ringBufferLoadAcquire(const uint32_t& pos) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __atomic_load_n(&pos, __ATOMIC_ACQUIRE);
+#else
+    const uint32_t value = *static_cast<const volatile uint32_t*>(&pos);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return value;
+#endif
+}
+
+/*
+ * Store a ring buffer position to be read by the other side.
+ * Release semantics, so data written before this call is visible to the other side after its matching load.
+ */
+static inline
+void d_ringBufferStoreRelease(uint32_t& pos, const uint32_t value) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __atomic_store_n(&pos, value, __ATOMIC_RELEASE);
+#else
+    std::atomic_thread_fence(std::memory_order_release);
+    *static_cast<volatile uint32_t*>(&pos) = value;
+#endif
+}
+
 // -----------------------------------------------------------------------
 // RingBufferControl templated class
 
@@ -196,7 +260,7 @@ public:
     {
         DISTRHO_SAFE_ASSERT_RETURN(buffer != nullptr, false);
 
-        return (buffer->buf == nullptr || buffer->head == buffer->tail);
+        return (buffer->buf == nullptr || d_ringBufferLoadAcquire(buffer->head) == d_ringBufferLoadAcquire(buffer->tail));
     }
 
     /*
@@ -214,9 +278,11 @@ public:
     {
         DISTRHO_SAFE_ASSERT_RETURN(buffer != nullptr, 0);
 
-        const uint32_t wrap = buffer->head >= buffer->tail ? 0 : buffer->size;
+        const uint32_t head = d_ringBufferLoadAcquire(buffer->head);
+        const uint32_t tail = d_ringBufferLoadAcquire(buffer->tail);
+        const uint32_t wrap = head >= tail ? 0 : buffer->size;
 
-        return wrap + buffer->head - buffer->tail;
+        return wrap + head - tail;
     }
 
     /*
@@ -226,9 +292,10 @@ public:
     {
         DISTRHO_SAFE_ASSERT_RETURN(buffer != nullptr, 0);
 
-        const uint32_t wrap = buffer->tail > buffer->wrtn ? 0 : buffer->size;
+        const uint32_t tail = d_ringBufferLoadAcquire(buffer->tail);
+        const uint32_t wrap = tail > buffer->wrtn ? 0 : buffer->size;
 
-        return wrap + buffer->tail - buffer->wrtn - 1;
+        return wrap + tail - buffer->wrtn - 1;
     }
 
     // -------------------------------------------------------------------
@@ -403,6 +470,105 @@ public:
         return false;
     }
 
+    /*!
+     * Copy an arbitrary amount of data, specified by @a size, without removing it from the buffer.
+     * This is wait-free, a following read operation will return the same data.
+     *
+     * Returns true if peeking succeeds.
+     * In case of failure, @a data pointer is automatically cleared by @a size bytes.
+     */
+    bool peekCustomData(void* const data, const uint32_t size) noexcept
+    {
+        DISTRHO_SAFE_ASSERT_RETURN(data != nullptr, false);
+        DISTRHO_SAFE_ASSERT_RETURN(size > 0, false);
+
+        if (tryRead(data, size, false))
+            return true;
+
+        std::memset(data, 0, size);
+        return false;
+    }
+
+    // -------------------------------------------------------------------
+    // zero-copy operations
+
+    /*
+     * Get a pointer to the data available for reading, without copying it.
+     * Returns the number of bytes that can be read from @a data,
+     * which might be less than getReadableDataSize() if the data wraps around the end of the buffer.
+     *
+     * Call releaseRead() afterwards with the number of bytes actually used,
+     * then call this function again to get the rest of wrapped data.
+     */
+    uint32_t acquireRead(const uint8_t*& data) noexcept
+    {
+        DISTRHO_SAFE_ASSERT_RETURN(buffer != nullptr, 0);
+
+        const uint32_t head = d_ringBufferLoadAcquire(buffer->head);
+        const uint32_t tail = buffer->tail;
+
+        data = buffer->buf + tail;
+        return head >= tail ? head - tail : buffer->size - tail;
+    }
+
+    /*
+     * Mark @a size bytes as read, after a call to acquireRead().
+     * This makes the space available to the writing side again.
+     */
+    void releaseRead(const uint32_t size) noexcept
+    {
+        DISTRHO_SAFE_ASSERT_RETURN(buffer != nullptr,);
+
+        uint32_t tail = buffer->tail + size;
+        DISTRHO_SAFE_ASSERT_UINT2_RETURN(tail <= buffer->size, tail, buffer->size,);
+
+        if (tail == buffer->size)
+            tail = 0;
+
+        d_ringBufferStoreRelease(buffer->tail, tail);
+    }
+
+    /*
+     * Get a pointer to the free space available for writing, so data can be written there directly.
+     * Returns the number of bytes that can be written into @a data,
+     * which might be less than getWritableDataSize() if the free space wraps around the end of the buffer.
+     *
+     * Call releaseWrite() afterwards with the number of bytes actually written,
+     * which like the other write operations only become visible to the reading side after commitWrite().
+     * Multiple blocks can be written this way before a single commit.
+     */
+    uint32_t acquireWrite(uint8_t*& data) noexcept
+    {
+        DISTRHO_SAFE_ASSERT_RETURN(buffer != nullptr, 0);
+
+        const uint32_t tail = d_ringBufferLoadAcquire(buffer->tail);
+        const uint32_t wrtn = buffer->wrtn;
+
+        data = buffer->buf + wrtn;
+
+        // one byte is always kept free, as head == tail means empty buffer
+        if (tail > wrtn)
+            return tail - wrtn - 1;
+
+        return buffer->size - wrtn - (tail == 0 ? 1 : 0);
+    }
+
+    /*
+     * Mark @a size bytes as written, after a call to acquireWrite().
+     */
+    void releaseWrite(const uint32_t size) noexcept
+    {
+        DISTRHO_SAFE_ASSERT_RETURN(buffer != nullptr,);
+
+        uint32_t wrtn = buffer->wrtn + size;
+        DISTRHO_SAFE_ASSERT_UINT2_RETURN(wrtn <= buffer->size, wrtn, buffer->size,);
+
+        if (wrtn == buffer->size)
+            wrtn = 0;
+
+        buffer->wrtn = wrtn;
+    }
+
     // -------------------------------------------------------------------
     // write operations
 
@@ -529,7 +695,7 @@ public:
         DISTRHO_SAFE_ASSERT_RETURN(buffer->head != buffer->wrtn, false);
 
         // all ok
-        buffer->head = buffer->wrtn;
+        d_ringBufferStoreRelease(buffer->head, buffer->wrtn);
         errorWriting = false;
         return true;
     }
@@ -552,8 +718,8 @@ public:
     // -------------------------------------------------------------------
 
 protected:
-    /** @internal try reading from the buffer, can fail. */
-    bool tryRead(void* const buf, const uint32_t size) noexcept
+    /** @internal try reading from the buffer, can fail. Does not remove the data from the buffer if @a advance is false. */
+    bool tryRead(void* const buf, const uint32_t size, const bool advance = true) noexcept
     {
         DISTRHO_SAFE_ASSERT_RETURN(buffer != nullptr, false);
        #if defined(__clang__)
@@ -568,14 +734,15 @@ protected:
         DISTRHO_SAFE_ASSERT_RETURN(size > 0, false);
         DISTRHO_SAFE_ASSERT_RETURN(size < buffer->size, false);
 
+        const uint32_t head = d_ringBufferLoadAcquire(buffer->head);
+        const uint32_t tail = buffer->tail;
+
         // empty
-        if (buffer->head == buffer->tail)
+        if (head == tail)
             return false;
 
         uint8_t* const bytebuf = static_cast<uint8_t*>(buf);
 
-        const uint32_t head = buffer->head;
-        const uint32_t tail = buffer->tail;
         const uint32_t wrap = head > tail ? 0 : buffer->size;
 
         if (size > wrap + head - tail)
@@ -613,7 +780,9 @@ protected:
                 readto = 0;
         }
 
-        buffer->tail = readto;
+        if (advance)
+            d_ringBufferStoreRelease(buffer->tail, readto);
+
         errorReading = false;
         return true;
     }
@@ -628,7 +797,7 @@ protected:
 
         const uint8_t* const bytebuf = static_cast<const uint8_t*>(buf);
 
-        const uint32_t tail = buffer->tail;
+        const uint32_t tail = d_ringBufferLoadAcquire(buffer->tail);
         const uint32_t wrtn = buffer->wrtn;
         const uint32_t wrap = tail > wrtn ? 0 : buffer->size;
 
@@ -689,13 +858,21 @@ private:
 template <class BufferStruct>
 inline bool RingBufferControl<BufferStruct>::isDataAvailableForReading() const noexcept
 {
-    return (buffer != nullptr && buffer->head != buffer->tail);
+    return (buffer != nullptr && d_ringBufferLoadAcquire(buffer->head) != d_ringBufferLoadAcquire(buffer->tail));
 }
 
 template <>
 inline bool RingBufferControl<HeapBuffer>::isDataAvailableForReading() const noexcept
 {
-    return (buffer != nullptr && buffer->buf != nullptr && buffer->head != buffer->tail);
+    return (buffer != nullptr && buffer->buf != nullptr
+            && d_ringBufferLoadAcquire(buffer->head) != d_ringBufferLoadAcquire(buffer->tail));
+}
+
+template <>
+inline bool RingBufferControl<PaddedHeapBuffer>::isDataAvailableForReading() const noexcept
+{
+    return (buffer != nullptr && buffer->buf != nullptr
+            && d_ringBufferLoadAcquire(buffer->head) != d_ringBufferLoadAcquire(buffer->tail));
 }
 
 // -----------------------------------------------------------------------
@@ -774,6 +951,74 @@ private:
     DISTRHO_DECLARE_NON_COPYABLE(HeapRingBuffer)
 };
 
+// -----------------------------------------------------------------------
+// RingBuffer using heap space, with padding between reading and writing positions
+
+/**
+   RingBufferControl with a cache-line padded heap buffer.
+   Same as HeapRingBuffer, but better suited for when reading and writing happen in parallel.
+   Requires the use of createBuffer(uint32_t) to make the ring buffer usable.
+   @see PaddedHeapBuffer
+*/
+class PaddedHeapRingBuffer : public RingBufferControl<PaddedHeapBuffer>
+{
+public:
+    /** Constructor. */
+    PaddedHeapRingBuffer() noexcept
+        : heapBuffer(PaddedHeapBuffer_INIT)
+    {
+#ifndef DISTRHO_PROPER_CPP11_SUPPORT
+        std::memset(&heapBuffer, 0, sizeof(heapBuffer));
+#endif
+    }
+
+    /** Destructor. */
+    ~PaddedHeapRingBuffer() noexcept override
+    {
+        if (heapBuffer.buf == nullptr)
+            return;
+
+        delete[] heapBuffer.buf;
+        heapBuffer.buf = nullptr;
+    }
+
+    /** Create a buffer of the specified size. */
+    bool createBuffer(const uint32_t size) noexcept
+    {
+        DISTRHO_SAFE_ASSERT_RETURN(heapBuffer.buf == nullptr, false);
+        DISTRHO_SAFE_ASSERT_RETURN(size > 0,  false);
+
+        const uint32_t p2size = d_nextPowerOf2(size);
+
+        try {
+            heapBuffer.buf = new uint8_t[p2size];
+        } DISTRHO_SAFE_EXCEPTION_RETURN("PaddedHeapRingBuffer::createBuffer", false);
+
+        heapBuffer.size = p2size;
+        setRingBuffer(&heapBuffer, true);
+        return true;
+    }
+
+    /** Delete the previously allocated buffer. */
+    void deleteBuffer() noexcept
+    {
+        DISTRHO_SAFE_ASSERT_RETURN(heapBuffer.buf != nullptr,);
+
+        setRingBuffer(nullptr, false);
+
+        delete[] heapBuffer.buf;
+        heapBuffer.buf  = nullptr;
+        heapBuffer.size = 0;
+    }
+
+private:
+    /** The heap buffer used for this class. */
+    PaddedHeapBuffer heapBuffer;
+
+    DISTRHO_PREVENT_VIRTUAL_HEAP_ALLOCATION
+    DISTRHO_DECLARE_NON_COPYABLE(PaddedHeapRingBuffer)
+};
+
 // -----------------------------------------------------------------------
 // RingBuffer using small stack space
 
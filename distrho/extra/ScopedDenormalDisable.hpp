@@ -38,16 +38,18 @@ public:
     /*
      * Constructor.
      * Current cpu flags will saved, then denormals-as-zero and flush-to-zero set on top.
+     * Writing the flags is skipped if they are already set, which is cheap enough for calling on every audio block.
      */
     inline ScopedDenormalDisable() noexcept;
 
     /*
      * Destructor.
-     * CPU flags will be restored to the value obtained in the constructor.
+     * CPU flags will be restored to the value obtained in the constructor, if they were changed.
      */
     inline ~ScopedDenormalDisable() noexcept
     {
-        setFlags(oldflags);
+        if (changed)
+            setFlags(oldflags);
     }
 
 private:
@@ -64,6 +66,9 @@ private:
     // retrieved on constructor, reset to it on destructor
     cpuflags_t oldflags;
 
+    // whether the constructor had to change the flags
+    bool changed;
+
     // helper function to set cpu flags
     inline void setFlags(cpuflags_t flags) noexcept;
 
@@ -75,18 +80,31 @@ private:
 // ScopedDenormalDisable class implementation
 
 inline ScopedDenormalDisable::ScopedDenormalDisable() noexcept
-    : oldflags(0)
+    : oldflags(0),
+      changed(false)
 {
    #if defined(__SSE2_MATH__)
     oldflags = _mm_getcsr();
-    setFlags(oldflags | 0x8040);
+    if ((oldflags & 0x8040) != 0x8040)
+    {
+        changed = true;
+        setFlags(oldflags | 0x8040);
+    }
    #elif defined(__aarch64__)
     __asm__ __volatile__("mrs %0, fpcr" : "=r" (oldflags));
-    setFlags(oldflags | 0x1000000);
-    __asm__ __volatile__("isb");
+    if ((oldflags & 0x1000000) == 0)
+    {
+        changed = true;
+        setFlags(oldflags | 0x1000000);
+        __asm__ __volatile__("isb");
+    }
    #elif defined(__arm__) && !defined(__SOFTFP__)
     __asm__ __volatile__("vmrs %0, fpscr" : "=r" (oldflags));
-    setFlags(oldflags | 0x1000000);
+    if ((oldflags & 0x1000000) == 0)
+    {
+        changed = true;
+        setFlags(oldflags | 0x1000000);
+    }
    #endif
 }
 
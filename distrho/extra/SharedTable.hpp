@@ -0,0 +1,399 @@
+/*
+ * DISTRHO Plugin Framework (DPF)
+ * Copyright (C) 2012-2023 Filipe Coelho <falktx@falktx.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any purpose with
+ * or without fee is hereby granted, provided that the above copyright notice and this
+ * permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+ * TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+ * NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+ * IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef DISTRHO_SHARED_TABLE_HPP_INCLUDED
+#define DISTRHO_SHARED_TABLE_HPP_INCLUDED
+
+#include "Mutex.hpp"
+
+#include <climits>
+#include <cstdio>
+
+#ifndef DISTRHO_OS_WINDOWS
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+// --------------------------------------------------------------------------------------------------------------------
+// SharedTable class
+
+/**
+   Handle to a read-only lookup table that is shared between all plugin instances in the same process.
+
+   Tables are identified by a @a Key (for example the sample rate) and created by a @a Builder on first use,
+   then reference-counted and destroyed once the last handle using them is released.
+   The @a Builder must provide the value type and 2 static functions, like this:
+   @code
+   struct SineTableBuilder {
+       typedef float ValueType;
+
+       static uint32_t getSize(const double sampleRate)
+       {
+           return static_cast<uint32_t>(sampleRate);
+       }
+
+       static void build(const double sampleRate, float* const table, const uint32_t size)
+       {
+           for (uint32_t i = 0; i < size; ++i)
+               table[i] = std::sin(2.0 * M_PI * i / sampleRate);
+       }
+   };
+
+   SharedTable<double, SineTableBuilder> sineTable;
+   @endcode
+
+   Tables can optionally be kept in a cache file, which is memory-mapped instead of being built again.
+   This makes every process using the same file share the same memory pages,
+   including other plugin binaries that would not share static data otherwise.
+   The cache filename should be unique for each key, for example by including the sample rate in it.
+   Cache files store the key and the builder version, files written for a different key or version are rebuilt.
+   The @a Builder can declare its version with `static const uint32_t version = 2;`,
+   which must be increased whenever build() changes its output. Builders without one use version 0.
+   Keys are compared by their bytes, so only plain value types (numbers or simple structs) can be used with cache files.
+   Cache files are only used on non-Windows systems, Windows always builds tables in memory.
+
+   Acquiring a table takes a lock and might build it, so it must be done outside of the audio thread,
+   typically in the plugin constructor or in plugin_sampleRateChanged().
+   Reading the table data is realtime safe.
+ */
+template <typename Key, class Builder>
+class SharedTable
+{
+public:
+    typedef typename Builder::ValueType ValueType;
+
+    /*
+     * Constructor.
+     * A call to acquire() is required before the table data becomes available.
+     */
+    SharedTable() noexcept
+        : entry(nullptr) {}
+
+    /*
+     * Destructor, releasing the table in use (if any).
+     */
+    ~SharedTable() noexcept
+    {
+        release();
+    }
+
+    /*
+     * Get the table for @a key, building it if no other handle in this process is using it.
+     * If @a cacheFilename is not null, the table is loaded from that file when possible,
+     * otherwise the file is written after the table is built.
+     * Any table previously acquired by this handle is released.
+     */
+    bool acquire(const Key& key, const char* const cacheFilename = nullptr)
+    {
+        Registry& registry(getRegistry());
+        const MutexLocker cml(registry.mutex);
+
+        if (entry != nullptr)
+        {
+            if (entry->key == key)
+                return true;
+
+            releaseEntry(registry, entry);
+            entry = nullptr;
+        }
+
+        for (Entry* e = registry.entries; e != nullptr; e = e->next)
+        {
+            if (e->key == key)
+            {
+                ++e->refCount;
+                entry = e;
+                return true;
+            }
+        }
+
+        const uint32_t size = Builder::getSize(key);
+        DISTRHO_SAFE_ASSERT_RETURN(size != 0, false);
+
+        Entry* const e = new Entry(key);
+        e->size = size;
+
+        if (cacheFilename == nullptr || ! loadCacheFile(e, cacheFilename))
+        {
+            ValueType* const data = new ValueType[size];
+            Builder::build(key, data, size);
+
+            e->data = data;
+            e->ownedData = data;
+
+            if (cacheFilename != nullptr)
+                writeCacheFile(cacheFilename, key, data, size);
+        }
+
+        e->next = registry.entries;
+        registry.entries = e;
+        entry = e;
+        return true;
+    }
+
+    /*
+     * Release the table in use, destroying it if this was the last handle using it.
+     */
+    void release() noexcept
+    {
+        if (entry == nullptr)
+            return;
+
+        Registry& registry(getRegistry());
+        const MutexLocker cml(registry.mutex);
+
+        releaseEntry(registry, entry);
+        entry = nullptr;
+    }
+
+    /*
+     * Check if this handle has a table in use.
+     */
+    bool isValid() const noexcept
+    {
+        return entry != nullptr;
+    }
+
+    /*
+     * Get the table data, or null if nothing has been acquired.
+     */
+    const ValueType* getData() const noexcept
+    {
+        return entry != nullptr ? entry->data : nullptr;
+    }
+
+    /*
+     * Get the number of values in the table.
+     */
+    uint32_t getSize() const noexcept
+    {
+        return entry != nullptr ? entry->size : 0;
+    }
+
+    /*
+     * Check if the table data comes from a memory-mapped cache file.
+     */
+    bool isMapped() const noexcept
+    {
+        return entry != nullptr && entry->mapped != nullptr;
+    }
+
+private:
+    struct Entry {
+        const Key key;
+        uint32_t refCount;
+        uint32_t size;
+        const ValueType* data;
+        ValueType* ownedData;
+        void* mapped;
+        size_t mappedSize;
+        Entry* next;
+
+        explicit Entry(const Key& k) noexcept
+            : key(k),
+              refCount(1),
+              size(0),
+              data(nullptr),
+              ownedData(nullptr),
+              mapped(nullptr),
+              mappedSize(0),
+              next(nullptr) {}
+
+        ~Entry() noexcept
+        {
+            delete[] ownedData;
+
+           #ifndef DISTRHO_OS_WINDOWS
+            if (mapped != nullptr)
+                munmap(mapped, mappedSize);
+           #endif
+        }
+
+        DISTRHO_DECLARE_NON_COPYABLE(Entry)
+    };
+
+    struct Registry {
+        Mutex mutex;
+        Entry* entries;
+
+        Registry() noexcept
+            : entries(nullptr) {}
+    };
+
+    // Cache file header, followed by the table values
+    struct CacheHeader {
+        char magic[4];
+        uint32_t valueSize;
+        uint32_t size;
+        uint32_t builderVersion;
+        uint32_t keySize;
+        uint32_t reserved;
+        uint64_t keyHash;
+    };
+
+    Entry* entry;
+
+    // one registry per Key and Builder combination, never destroyed as handles might outlive static data
+    static Registry& getRegistry()
+    {
+        static Registry* const registry = new Registry();
+        return *registry;
+    }
+
+    static void releaseEntry(Registry& registry, Entry* const e) noexcept
+    {
+        if (--e->refCount != 0)
+            return;
+
+        for (Entry** it = &registry.entries; *it != nullptr; it = &(*it)->next)
+        {
+            if (*it == e)
+            {
+                *it = e->next;
+                break;
+            }
+        }
+
+        delete e;
+    }
+
+    // Builder::version if declared, 0 otherwise
+    template <class B>
+    static uint32_t getBuilderVersion(decltype(&B::version)) noexcept
+    {
+        return B::version;
+    }
+
+    template <class B>
+    static uint32_t getBuilderVersion(...) noexcept
+    {
+        return 0;
+    }
+
+    // FNV-1a hash of the key bytes
+    static uint64_t getKeyHash(const Key& key) noexcept
+    {
+        const uint8_t* const bytes = reinterpret_cast<const uint8_t*>(&key);
+        uint64_t hash = 14695981039346656037ULL;
+
+        for (size_t i = 0; i < sizeof(Key); ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+
+        return hash;
+    }
+
+    static void fillCacheHeader(CacheHeader& header, const Key& key, const uint32_t size) noexcept
+    {
+        std::memcpy(header.magic, "DPFT", 4);
+        header.valueSize = sizeof(ValueType);
+        header.size = size;
+        header.builderVersion = getBuilderVersion<Builder>(nullptr);
+        header.keySize = sizeof(Key);
+        header.reserved = 0;
+        header.keyHash = getKeyHash(key);
+    }
+
+    static bool isValidCacheHeader(const CacheHeader& header, const Key& key, const uint32_t size) noexcept
+    {
+        CacheHeader expected;
+        fillCacheHeader(expected, key, size);
+
+        return std::memcmp(&header, &expected, sizeof(CacheHeader)) == 0;
+    }
+
+    static bool loadCacheFile(Entry* const e, const char* const filename)
+    {
+       #ifdef DISTRHO_OS_WINDOWS
+        return false;
+
+        // unused
+        (void)e;
+        (void)filename;
+       #else
+        const int fd = open(filename, O_RDONLY);
+
+        if (fd < 0)
+            return false;
+
+        const size_t expectedSize = sizeof(CacheHeader) + sizeof(ValueType) * e->size;
+        struct stat st;
+
+        if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) != expectedSize)
+        {
+            close(fd);
+            return false;
+        }
+
+        void* const mapped = mmap(nullptr, expectedSize, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+
+        if (mapped == MAP_FAILED)
+            return false;
+
+        if (! isValidCacheHeader(*static_cast<const CacheHeader*>(mapped), e->key, e->size))
+        {
+            munmap(mapped, expectedSize);
+            return false;
+        }
+
+        e->data = reinterpret_cast<const ValueType*>(static_cast<const uint8_t*>(mapped) + sizeof(CacheHeader));
+        e->mapped = mapped;
+        e->mappedSize = expectedSize;
+        return true;
+       #endif
+    }
+
+    static void writeCacheFile(const char* const filename, const Key& key, const ValueType* const data, const uint32_t size)
+    {
+       #ifdef DISTRHO_OS_WINDOWS
+        // unused
+        (void)filename;
+        (void)key;
+        (void)data;
+        (void)size;
+       #else
+        // write to a temporary file first, so other processes never map a partially written one
+        char tmpFilename[PATH_MAX];
+        std::snprintf(tmpFilename, sizeof(tmpFilename), "%s.%d.tmp", filename, static_cast<int>(getpid()));
+
+        FILE* const file = std::fopen(tmpFilename, "wb");
+        DISTRHO_SAFE_ASSERT_RETURN(file != nullptr,);
+
+        CacheHeader header;
+        fillCacheHeader(header, key, size);
+
+        const bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1
+                     && std::fwrite(data, sizeof(ValueType), size, file) == size;
+
+        if (std::fclose(file) == 0 && ok && std::rename(tmpFilename, filename) == 0)
+            return;
+
+        d_stderr2("SharedTable: failed to write cache file '%s'", filename);
+        std::remove(tmpFilename);
+       #endif
+    }
+
+    DISTRHO_DECLARE_NON_COPYABLE(SharedTable)
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+#endif // DISTRHO_SHARED_TABLE_HPP_INCLUDED
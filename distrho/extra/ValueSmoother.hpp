@@ -100,11 +100,90 @@ public:
         return (mem = mem * coef + target * (1.f - coef));
     }
 
+    /**
+     * Write the next @a frames smoothed values into @a out.
+     * Uses the closed form y[n] = target + (y[0] - target) * coef^n, computed over 4 independent lanes,
+     * and degenerates into a constant fill once the target has been reached.
+     */
+    void processBlock(float* const out, const uint32_t frames) noexcept
+    {
+        render<false>(out, frames);
+    }
+
+    /**
+     * Multiply @a buf in-place by the next @a frames smoothed values.
+     * Same as processBlock(), but meant to be used directly as a gain ramp.
+     */
+    void applyGain(float* const buf, const uint32_t frames) noexcept
+    {
+        render<true>(buf, frames);
+    }
+
 private:
     void updateCoef() noexcept
     {
         coef = std::exp(-1.f / (tau * sampleRate));
     }
+
+    template <bool kApplyGain>
+    void render(float* const buf, const uint32_t frames) noexcept
+    {
+        const float diff = mem - target;
+
+        // already at target, constant fill/multiply
+        if (d_isZero(diff) || target + diff == target)
+        {
+            mem = target;
+
+            if (kApplyGain)
+            {
+                if (d_isNotEqual(target, 1.f))
+                    for (uint32_t i=0; i<frames; ++i)
+                        buf[i] *= target;
+            }
+            else
+            {
+                for (uint32_t i=0; i<frames; ++i)
+                    buf[i] = target;
+            }
+            return;
+        }
+
+        const float c1 = coef;
+        const float c2 = c1 * c1;
+        const float c4 = c2 * c2;
+        float d[4] = { diff * c1, diff * c2, diff * c2 * c1, diff * c4 };
+        float last = mem;
+
+        uint32_t i = 0;
+        for (; i + 4 <= frames; i += 4)
+        {
+            for (uint32_t j=0; j<4; ++j)
+            {
+                const float value = target + d[j];
+
+                if (kApplyGain)
+                    buf[i + j] *= value;
+                else
+                    buf[i + j] = value;
+
+                d[j] *= c4;
+                last = value;
+            }
+        }
+
+        for (uint32_t j=0; i<frames; ++i, ++j)
+        {
+            last = target + d[j];
+
+            if (kApplyGain)
+                buf[i] *= last;
+            else
+                buf[i] = last;
+        }
+
+        mem = last;
+    }
 };
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -189,11 +268,206 @@ public:
         return (mem = y0 + std::copysign(std::fmin(std::abs(dy), std::abs(step)), dy));
     }
 
+    /**
+     * Write the next @a frames smoothed values into @a out.
+     * The segment is computed as y[0] + step * n (no serial dependency between samples),
+     * and degenerates into a constant fill once the target has been reached.
+     */
+    void processBlock(float* const out, const uint32_t frames) noexcept
+    {
+        render<false>(out, frames);
+    }
+
+    /**
+     * Multiply @a buf in-place by the next @a frames smoothed values.
+     * Same as processBlock(), but meant to be used directly as a gain ramp.
+     */
+    void applyGain(float* const buf, const uint32_t frames) noexcept
+    {
+        render<true>(buf, frames);
+    }
+
 private:
     void updateStep() noexcept
     {
         step = (target - mem) / (tau * sampleRate);
     }
+
+    template <bool kApplyGain>
+    void render(float* const buf, const uint32_t frames) noexcept
+    {
+        const float y0 = mem;
+        const float dy = target - y0;
+        const float absStep = std::abs(step);
+
+        // number of full steps before reaching target, the sample after that lands on target exactly.
+        // a step bigger than the distance (or not a number) jumps straight to target, same as next()
+        uint32_t ramp = 0;
+        if (absStep < std::abs(dy))
+        {
+            const float steps = std::abs(dy) / absStep;
+            ramp = steps < static_cast<float>(frames) ? static_cast<uint32_t>(steps) : frames;
+        }
+
+        const float signedStep = std::copysign(absStep, dy);
+
+        for (uint32_t i=0; i<ramp; ++i)
+        {
+            const float value = y0 + signedStep * static_cast<float>(i + 1);
+
+            if (kApplyGain)
+                buf[i] *= value;
+            else
+                buf[i] = value;
+        }
+
+        // already at target, constant fill/multiply
+        if (kApplyGain)
+        {
+            if (d_isNotEqual(target, 1.f))
+                for (uint32_t i=ramp; i<frames; ++i)
+                    buf[i] *= target;
+        }
+        else
+        {
+            for (uint32_t i=ramp; i<frames; ++i)
+                buf[i] = target;
+        }
+
+        mem = ramp == frames ? y0 + signedStep * static_cast<float>(frames) : target;
+    }
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief A bank of exponential smoothers sharing the same time constant
+ *
+ * This smooths @a N control values together, behaving like @a N ExponentialValueSmoother instances.
+ *
+ * All lanes are kept in plain arrays and updated in a single loop,
+ * so that compilers can keep them in SIMD registers instead of running one dependency chain per value.
+ * Useful for plugins with many smoothed parameters, like per-band gains or per-channel pan.
+ */
+template <uint32_t N>
+class SmootherBank {
+    float coef;
+    float tau;
+    float sampleRate;
+    float target[N];
+    float mem[N];
+
+public:
+    SmootherBank()
+        : coef(0.f),
+          tau(0.f),
+          sampleRate(0.f)
+    {
+        std::memset(target, 0, sizeof(target));
+        std::memset(mem, 0, sizeof(mem));
+    }
+
+    void setSampleRate(const float newSampleRate) noexcept
+    {
+        if (d_isNotEqual(sampleRate, newSampleRate))
+        {
+            sampleRate = newSampleRate;
+            updateCoef();
+        }
+    }
+
+    void setTimeConstant(const float newT60) noexcept
+    {
+        const float newTau = newT60 * (float)(1.0 / 6.91);
+
+        if (d_isNotEqual(tau, newTau))
+        {
+            tau = newTau;
+            updateCoef();
+        }
+    }
+
+    float getCurrentValue(const uint32_t index) const noexcept
+    {
+        DISTRHO_SAFE_ASSERT_RETURN(index < N, 0.f);
+        return mem[index];
+    }
+
+    float getTargetValue(const uint32_t index) const noexcept
+    {
+        DISTRHO_SAFE_ASSERT_RETURN(index < N, 0.f);
+        return target[index];
+    }
+
+    void setTargetValue(const uint32_t index, const float newTarget) noexcept
+    {
+        DISTRHO_SAFE_ASSERT_RETURN(index < N,);
+        target[index] = newTarget;
+    }
+
+    void clearToTargetValues() noexcept
+    {
+        std::memcpy(mem, target, sizeof(mem));
+    }
+
+    /**
+     * Check if all lanes have reached their target value.
+     */
+    bool isSettled() const noexcept
+    {
+        for (uint32_t k=0; k<N; ++k)
+        {
+            const float diff = mem[k] - target[k];
+
+            // the recursion in next() can get stuck an ulp away from the target, count that as settled too
+            if (! (d_isZero(diff) || target[k] + diff * coef == mem[k]))
+                return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * Advance all lanes by one sample, writing the @a N new values into @a values.
+     */
+    inline void next(float values[N]) noexcept
+    {
+        for (uint32_t k=0; k<N; ++k)
+            values[k] = mem[k] = target[k] + (mem[k] - target[k]) * coef;
+    }
+
+    /**
+     * Write the next @a frames smoothed values of each lane into @a outputs[lane].
+     * Degenerates into a constant fill once all lanes have reached their target.
+     */
+    void processBlock(float* const* const outputs, const uint32_t frames) noexcept
+    {
+        if (isSettled())
+        {
+            clearToTargetValues();
+
+            for (uint32_t k=0; k<N; ++k)
+                for (uint32_t i=0; i<frames; ++i)
+                    outputs[k][i] = target[k];
+            return;
+        }
+
+        float values[N];
+
+        for (uint32_t i=0; i<frames; ++i)
+        {
+            next(values);
+
+            for (uint32_t k=0; k<N; ++k)
+                outputs[k][i] = values[k];
+        }
+    }
+
+private:
+    void updateCoef() noexcept
+    {
+        coef = std::exp(-1.f / (tau * sampleRate));
+    }
 };
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -339,6 +339,7 @@ const char *x_fib_recent_file(const char *appname) {
 
 #ifdef HAVE_X11
 #include <dirent.h>
+#include <pthread.h>
 
 #include <X11/Xlib.h>
 #include <X11/Xatom.h>
@@ -424,7 +425,7 @@ typedef struct {
 	int ssizew;
 	off_t size;
 	time_t mtime;
-	uint8_t flags; // 2: selected, 4: isdir 8: recent-entry
+	uint8_t flags; // 2: selected, 4: isdir 8: recent-entry 16: size and time not queried yet
 	FibRecentFile *rfp;
 } FibFileEntry;
 
@@ -519,6 +520,8 @@ static void VDrawRectangle (Display *dpy, Drawable d, GC gc, int x, int y, unsig
 #endif
 }
 
+static void fib_load_meta_range (Display *dpy, int start, int end);
+
 static void fib_expose (Display *dpy, Window realwin) {
 	int i;
 	XID win;
@@ -611,6 +614,14 @@ static void fib_expose (Display *dpy, Window realwin) {
 	// middle, scroll list of file names
 	const int ltop = LISTTOP * _fib_font_vsep;
 	const int llen = (_fib_height - LISTBOT * _fib_font_vsep) / _fib_font_vsep;
+
+	// size and time are only queried for visible entries, before column widths are known
+	if (_scrl_f > 0 && _scrl_f + llen > _dircount) {
+		fib_load_meta_range (dpy, _dircount - llen, _dircount);
+	} else {
+		fib_load_meta_range (dpy, _scrl_f, _scrl_f + llen);
+	}
+
 	const int fsel_height = 4 * _scalefactor + llen * _fib_font_vsep;
 	const int fsel_width = _fib_width - (FAREAMRGL + FAREAMRGR) * _scalefactor - (llen < _dircount ? SCROLLBARW * _scalefactor : 0);
 	const int t_x = FAREATEXTL * _scalefactor;
@@ -1115,20 +1126,49 @@ static void fmt_time (Display *dpy, FibFileEntry *f) {
 	}
 }
 
-static void fib_resort (const char * sel) {
-	if (_dircount < 1) { return; }
-	int (*sortfn)(const void *p1, const void *p2);
+typedef int (*FibSortFn)(const void *p1, const void *p2);
+
+static FibSortFn fib_sortfn () {
 	switch (_sort) {
-		case 1: sortfn = &cmp_n_down; break;
-		case 2: sortfn = &cmp_s_down; break;
-		case 3: sortfn = &cmp_s_up; break;
-		case 4: sortfn = &cmp_t_down; break;
-		case 5: sortfn = &cmp_t_up; break;
-		default:
-						sortfn = &cmp_n_up;
-						break;
+		case 1: return &cmp_n_down;
+		case 2: return &cmp_s_down;
+		case 3: return &cmp_s_up;
+		case 4: return &cmp_t_down;
+		case 5: return &cmp_t_up;
+		default: return &cmp_n_up;
 	}
-	qsort (_dirlist, _dircount, sizeof(_dirlist[0]), sortfn);
+}
+
+static void fib_load_meta (Display *dpy, FibFileEntry *f) {
+	char tp[1024];
+	struct stat fs;
+	f->flags &= ~16;
+	if (strlen (_cur_path) + strlen (f->name) >= sizeof(tp)) return;
+	strcpy (tp, _cur_path);
+	strcat (tp, f->name);
+	if (stat (tp, &fs)) return;
+	f->mtime = fs.st_mtime;
+	f->size = fs.st_size;
+	if (!(f->flags & 4))
+		fmt_size (dpy, f);
+	fmt_time (dpy, f);
+}
+
+static void fib_load_meta_range (Display *dpy, int start, int end) {
+	int i;
+	for (i = MAX (0, start); i < end && i < _dircount; ++i) {
+		if (_dirlist[i].flags & 16) {
+			fib_load_meta (dpy, &_dirlist[i]);
+		}
+	}
+}
+
+static void fib_resort (Display *dpy, const char * sel) {
+	if (_dircount < 1) { return; }
+	if (_sort >= 2) { // sorting by size or time needs all of them
+		fib_load_meta_range (dpy, 0, _dircount);
+	}
+	qsort (_dirlist, _dircount, sizeof(_dirlist[0]), fib_sortfn ());
 	int i;
 	for (i = 0; i < _dircount && sel; ++i) {
 		if (!strcmp (_dirlist[i].name, sel)) {
@@ -1167,7 +1207,250 @@ static inline int fib_filter (const char *name) {
 	}
 }
 
+/* Directories are read on a background thread, which only collects names and types.
+ * Entries are merged into the sorted list by fib_scan_merge() from x_fib_idle(),
+ * while size and time are queried later, only for the entries that are displayed.
+ */
+
+#define FIB_SCAN_BATCH 128
+
+typedef struct {
+	char name[256];
+	uint8_t flags; // 4: isdir
+} FibScanEntry;
+
+/* state of one directory scan, owned by the dialog.
+ * The reading thread is always joined before this is freed,
+ * so no code of this library keeps running after x_fib_close().
+ */
+typedef struct {
+	DIR *dir;            // owned by whoever is reading
+	int hidden;          // copy of _fib_hidden_fn
+	char path[1024];     // copy of _cur_path
+	pthread_t thread;
+	uint8_t threaded;    // thread needs to be joined
+	uint8_t cancel;      // atomic, checked for every entry
+	uint8_t done;        // protected by _scan_lock
+	FibScanEntry *buf;   // protected by _scan_lock
+	int cnt;             // protected by _scan_lock
+	int alloc;           // protected by _scan_lock
+} FibScan;
+
+static pthread_mutex_t _scan_lock = PTHREAD_MUTEX_INITIALIZER;
+static FibScan        *_scan = NULL;        // scan of the current directory, if still reading
+static char            _scan_sel[256] = ""; // entry to select once it shows up
+
+/* read up to @max entries, returns 1 when the end of the directory is reached */
+static int fib_scan_read (FibScan *scan, FibScanEntry *batch, int max, int *cnt) {
+	char tp[1024];
+	struct stat fs;
+	struct dirent *de;
+	*cnt = 0;
+	while (*cnt < max) {
+		if (__atomic_load_n (&scan->cancel, __ATOMIC_RELAXED)) return 1;
+		if (!(de = readdir (scan->dir))) return 1;
+		if (!scan->hidden && de->d_name[0] == '.') continue;
+		if (!strcmp (de->d_name, ".")) continue;
+		if (!strcmp (de->d_name, "..")) continue;
+		if (strlen (scan->path) + strlen (de->d_name) >= sizeof(tp)) continue;
+		strcpy (tp, scan->path);
+		strcat (tp, de->d_name);
+		if (access (tp, R_OK)) continue;
+
+		FibScanEntry *e = &batch[*cnt];
+#ifdef _DIRENT_HAVE_D_TYPE
+		if (de->d_type == DT_DIR) {
+			e->flags = 4;
+		} else if (de->d_type == DT_REG) {
+			e->flags = 0;
+		} else if (de->d_type != DT_UNKNOWN && de->d_type != DT_LNK) {
+			continue;
+		} else
+#endif
+		{
+			if (stat (tp, &fs)) continue;
+			if (S_ISDIR (fs.st_mode)) e->flags = 4;
+			else if (S_ISREG (fs.st_mode)) e->flags = 0;
+			else continue;
+		}
+		strcpy (e->name, de->d_name);
+		++*cnt;
+	}
+	return 0;
+}
+
+/* hand entries over to the dialog */
+static void fib_scan_push (FibScan *scan, const FibScanEntry *batch, int cnt, int done) {
+	pthread_mutex_lock (&_scan_lock);
+	if (cnt > 0) {
+		if (scan->cnt + cnt > scan->alloc) {
+			scan->alloc = MAX (scan->cnt + cnt, scan->alloc * 2);
+			scan->buf = (FibScanEntry*) realloc (scan->buf, scan->alloc * sizeof(FibScanEntry));
+		}
+		memcpy (scan->buf + scan->cnt, batch, cnt * sizeof(FibScanEntry));
+		scan->cnt += cnt;
+	}
+	if (done) scan->done = 1;
+	pthread_mutex_unlock (&_scan_lock);
+}
+
+static void *fib_scan_thread (void *arg) {
+	FibScan *scan = (FibScan*) arg;
+	FibScanEntry *batch = (FibScanEntry*) malloc (FIB_SCAN_BATCH * sizeof(FibScanEntry));
+	int cnt, done = 0;
+	while (!done) {
+		done = fib_scan_read (scan, batch, FIB_SCAN_BATCH, &cnt);
+		fib_scan_push (scan, batch, cnt, done);
+	}
+	free (batch);
+	closedir (scan->dir);
+	scan->dir = NULL;
+	return NULL;
+}
+
+/* the reading thread checks for cancellation between entries, so waiting for it is short */
+static void fib_scan_free (FibScan *scan) {
+	__atomic_store_n (&scan->cancel, 1, __ATOMIC_RELAXED);
+	if (scan->threaded) pthread_join (scan->thread, NULL);
+	if (scan->dir) closedir (scan->dir);
+	free (scan->buf);
+	free (scan);
+}
+
+static void fib_scan_stop () {
+	_scan_sel[0] = '\0';
+	if (!_scan) return;
+	fib_scan_free (_scan);
+	_scan = NULL;
+}
+
+/* takes ownership of @dir, the first batch of entries is read right away */
+static void fib_scan_start (DIR *dir, const char *sel) {
+	FibScanEntry *batch = (FibScanEntry*) malloc (FIB_SCAN_BATCH * sizeof(FibScanEntry));
+	FibScan *scan = (FibScan*) calloc (1, sizeof(FibScan));
+	int cnt;
+	scan->dir = dir;
+	scan->hidden = _fib_hidden_fn;
+	strcpy (scan->path, _cur_path);
+	if (sel && strlen (sel) < sizeof(_scan_sel)) {
+		strcpy (_scan_sel, sel);
+	} else {
+		_scan_sel[0] = '\0';
+	}
+	_scan = scan;
+
+	const int done = fib_scan_read (scan, batch, FIB_SCAN_BATCH, &cnt);
+	fib_scan_push (scan, batch, cnt, done);
+	free (batch);
+
+	if (done) {
+		closedir (dir);
+		scan->dir = NULL;
+		return;
+	}
+
+	if (!pthread_create (&scan->thread, NULL, fib_scan_thread, scan)) {
+		scan->threaded = 1;
+	} else {
+		fib_scan_thread (scan); // read everything now instead
+	}
+}
+
+/* entries in [0, @nold) are sorted, sort the rest and merge them in */
+static void fib_merge_sorted (const int nold) {
+	const FibSortFn sortfn = fib_sortfn ();
+	const int nnew = _dircount - nold;
+	if (nnew < 1) return;
+	qsort (_dirlist + nold, nnew, sizeof(_dirlist[0]), sortfn);
+	if (nold == 0 || sortfn (&_dirlist[nold - 1], &_dirlist[nold]) <= 0) return;
+
+	// merge from the back, so only the new entries need a temporary copy
+	FibFileEntry *tmp = (FibFileEntry*) malloc (nnew * sizeof(FibFileEntry));
+	memcpy (tmp, _dirlist + nold, nnew * sizeof(FibFileEntry));
+	int i = nold - 1, j = nnew - 1, k = _dircount - 1;
+	while (j >= 0) {
+		if (i >= 0 && sortfn (&_dirlist[i], &tmp[j]) > 0) {
+			_dirlist[k--] = _dirlist[i--];
+		} else {
+			_dirlist[k--] = tmp[j--];
+		}
+	}
+	free (tmp);
+}
+
+/* add entries read so far to the list.
+ * @return 0 if nothing changed, 1 if entries were added, 2 if the requested selection showed up
+ */
+static int fib_scan_merge (Display *dpy) {
+	FibScanEntry *buf;
+	int i, cnt, done, rv = 1;
+	if (!_scan) return 0;
+
+	pthread_mutex_lock (&_scan_lock);
+	buf = _scan->buf;
+	cnt = _scan->cnt;
+	done = _scan->done;
+	_scan->buf = NULL;
+	_scan->cnt = _scan->alloc = 0;
+	pthread_mutex_unlock (&_scan_lock);
+
+	if (done) {
+		fib_scan_free (_scan);
+		_scan = NULL;
+	}
+
+	if (cnt == 0) {
+		free (buf);
+		if (done) _scan_sel[0] = '\0';
+		return 0;
+	}
+
+	const int nold = _dircount;
+	_dirlist = (FibFileEntry*) realloc (_dirlist, (nold + cnt) * sizeof(FibFileEntry));
+	for (i = 0; i < cnt; ++i) {
+		if (!(buf[i].flags & 4) && !fib_filter (buf[i].name)) continue;
+		FibFileEntry *f = &_dirlist[_dircount++];
+		memset (f, 0, sizeof(FibFileEntry));
+		strcpy (f->name, buf[i].name);
+		f->flags = (buf[i].flags & 4) | 16;
+	}
+	free (buf);
+
+	if (_sort >= 2) { // sorting by size or time needs them right away
+		fib_load_meta_range (dpy, nold, _dircount);
+	}
+	fib_merge_sorted (nold);
+
+	// keep the selected entry, which might have moved
+	_fsel = -1;
+	for (i = 0; i < _dircount; ++i) {
+		if (_dirlist[i].flags & 2) {
+			_fsel = i;
+			break;
+		}
+	}
+	if (_scan_sel[0]) {
+		for (i = 0; i < _dircount; ++i) {
+			if (!strcmp (_dirlist[i].name, _scan_sel)) {
+				if (_fsel >= 0) _dirlist[_fsel].flags &= ~2;
+				_fsel = i;
+				_dirlist[i].flags |= 2;
+				_scan_sel[0] = '\0';
+				rv = 2;
+				break;
+			}
+		}
+	}
+	if (_fsel < 0 && _dircount > 0) {
+		_fsel = 0;
+		_dirlist[0].flags |= 2;
+	}
+	if (done) _scan_sel[0] = '\0';
+	return rv;
+}
+
 static void fib_pre_opendir (Display *dpy) {
+	fib_scan_stop ();
 	if (_dirlist) free (_dirlist);
 	if (_pathbtn) free (_pathbtn);
 	_dirlist = NULL;
@@ -1184,7 +1467,7 @@ static void fib_post_opendir (Display *dpy, const char *sel) {
 		_fsel = 0; // select first
 	else
 		_fsel = -1;
-	fib_resort (sel);
+	fib_resort (dpy, sel);
 
 	if (_dircount > 0 && _fsel >= 0) {
 		fib_select (dpy, _fsel);
@@ -1281,31 +1564,13 @@ static int fib_opendir (Display *dpy, const char* path, const char *sel) {
 	if (!dir) {
 		strcpy (_cur_path, "/");
 	} else {
-		int i;
-		struct dirent *de;
 		if (path != _cur_path)
 			strcpy (_cur_path, path);
 
 		if (_cur_path[strlen (_cur_path) -1] != '/')
 			strcat (_cur_path, "/");
 
-		while ((de = readdir (dir))) {
-			if (!_fib_hidden_fn && de->d_name[0] == '.') continue;
-			++_dircount;
-		}
-
-		if (_dircount > 0)
-			_dirlist = (FibFileEntry*) calloc (_dircount, sizeof(FibFileEntry));
-
-		rewinddir (dir);
-
-		i = 0;
-		while ((de = readdir (dir))) {
-			if (!fib_dirlistadd (dpy, i, _cur_path, de->d_name, 0))
-				++i;
-		}
-		_dircount = i;
-		closedir (dir);
+		fib_scan_start (dir, sel);
 	}
 
 	t0 = _cur_path;
@@ -1331,8 +1596,20 @@ static int fib_opendir (Display *dpy, const char* path, const char *sel) {
 		t1 = t0 + 1;
 		++i;
 	}
-	fib_post_opendir (dpy, sel);
-	return _dircount;
+
+	if (!dir) {
+		fib_post_opendir (dpy, sel);
+		return 0;
+	}
+
+	// the remaining entries are added by x_fib_idle()
+	if (fib_scan_merge (dpy) == 2) {
+		fib_select (dpy, _fsel);
+	} else {
+		fib_expose (dpy, _fib_win);
+	}
+	// success depends on the directory itself, entries might all be filtered out or still being read
+	return 1;
 }
 
 static int fib_open (Display *dpy, int item) {
@@ -1660,10 +1937,10 @@ static void fib_mousedown (Display *dpy, int x, int y, int btn, unsigned long ti
 					assert (_dirlist && _dircount >= _fsel);
 					_dirlist[_fsel].flags &= ~2;
 					char *sel = strdup (_dirlist[_fsel].name);
-					fib_resort (sel);
+					fib_resort (dpy, sel);
 					free (sel);
 				} else {
-					fib_resort (NULL);
+					fib_resort (dpy, NULL);
 					_fsel = -1;
 				}
 				fib_reset ();
@@ -2128,6 +2405,7 @@ int x_fib_show (Display *dpy, Window parent, int x, int y, double scalefactor) {
 
 void x_fib_close (Display *dpy) {
 	if (!_fib_win) return;
+	fib_scan_stop ();
 	XFreeGC (dpy, _fib_gc);
 	XDestroyWindow (dpy, _fib_win);
 	_fib_win = 0;
@@ -2295,6 +2573,21 @@ int x_fib_status () {
 	return _status;
 }
 
+int x_fib_idle (Display *dpy) {
+	if (!_fib_win) return 0;
+	if (_status) return 0;
+	switch (fib_scan_merge (dpy)) {
+		case 1:
+			fib_expose (dpy, _fib_win);
+			return 1;
+		case 2:
+			fib_select (dpy, _fsel);
+			return 1;
+		default:
+			return 0;
+	}
+}
+
 int x_fib_configure (int k, const char *v) {
 	if (_fib_win) { return -1; }
 	switch (k) {
@@ -2455,6 +2748,7 @@ int main (int argc, char **argv) {
 
 	while (1) {
 		XEvent event;
+		x_fib_idle (dpy);
 		while (XPending (dpy) > 0) {
 			XNextEvent (dpy, &event);
 			if (x_fib_handle_events (dpy, &event)) {
@@ -64,6 +64,18 @@ void x_fib_close (Display *dpy);
  */
 int x_fib_handle_events (Display *dpy, XEvent *event);
 
+/** add directory entries read in the background since the last call.
+ * Directories are read asynchronously, this must be called
+ * periodically (e.g. from the application idle loop) while
+ * the dialog is open, so that the file list gets filled.
+ * It is safe to run this function even if the dialog is
+ * closed or was not initialized.
+ *
+ * @param dpy X Display connection
+ * @return 1 if the file list changed, 0 otherwise
+ */
+int x_fib_idle (Display *dpy);
+
 /** last status of the dialog
  * @return >0: file was selected, <0: canceled or inactive. 0: active
  */
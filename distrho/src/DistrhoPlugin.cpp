@@ -24,6 +24,7 @@ uint32_t    d_nextBufferSize = 0;
 double      d_nextSampleRate = 0.0;
 const char* d_nextBundlePath = nullptr;
 bool        d_nextCanRequestParameterValueChanges = false;
+bool        d_nextPluginIsDummy = false;
 
 /* ------------------------------------------------------------------------------------------------------------
  * Static fallback data, see DistrhoPluginInternal.hpp */
@@ -34,6 +35,16 @@ const ParameterRanges            PluginExporter::sFallbackRanges;
 const ParameterEnumerationValues PluginExporter::sFallbackEnumValues;
 const PortGroupWithId            PluginExporter::sFallbackPortGroup;
 
+/* ------------------------------------------------------------------------------------------------------------
+ * Shared data, see DistrhoPluginInternal.hpp */
+
+PluginSharedData* PluginExporter::sSharedData = nullptr;
+Mutex             PluginExporter::sSharedDataMutex;
+
+#if DISTRHO_PLUGIN_WANT_INSTANCE_POOL
+PluginInstancePool PluginExporter::sInstancePool;
+#endif
+
 /* ------------------------------------------------------------------------------------------------------------
  * Host state */
 
@@ -75,6 +86,35 @@ bool plugin_requestParameterValueChange(void* ptr, const uint32_t index, const f
 }
 #endif
 
+uint64_t plugin_getInputSilenceMask(void* ptr)
+{
+    PluginPrivateData* pData = getPluginPrivateData(ptr);
+    DISTRHO_SAFE_ASSERT_RETURN(pData->isProcessing, 0);
+    return pData->inputSilenceMask;
+}
+
+void plugin_setOutputSilenceMask(void* ptr, const uint64_t mask)
+{
+    PluginPrivateData* pData = getPluginPrivateData(ptr);
+    DISTRHO_SAFE_ASSERT_RETURN(pData->isProcessing,);
+    pData->outputSilenceMask = mask;
+}
+
+bool plugin_isInPlace(void* ptr, const uint32_t channel)
+{
+#if DISTRHO_PLUGIN_NUM_INPUTS > 0
+    PluginPrivateData* pData = getPluginPrivateData(ptr);
+    DISTRHO_SAFE_ASSERT_RETURN(pData->isProcessing, true);
+    DISTRHO_SAFE_ASSERT_UINT_RETURN(channel < DISTRHO_PLUGIN_NUM_INPUTS, channel, false);
+    return pData->inputsInPlace[channel];
+#else
+    // unused
+    (void)ptr;
+    (void)channel;
+    return false;
+#endif
+}
+
 /* ------------------------------------------------------------------------------------------------------------
  * Init */
 
@@ -43,9 +43,14 @@
 # include "../extra/RingBuffer.hpp"
 #endif
 
+#include <atomic>
 #include <map>
 #include <vector>
 
+#ifdef _MSC_VER
+# include <intrin.h>
+#endif
+
 #include "clap/entry.h"
 #include "clap/plugin-factory.h"
 #include "clap/ext/audio-ports.h"
@@ -72,6 +77,23 @@
 
 typedef std::map<const String, String> StringMap;
 
+// index of the lowest set bit, bits must be non-zero
+static inline uint32_t countTrailingZeros(const uint32_t bits) noexcept
+{
+   #if defined(__GNUC__) || defined(__clang__)
+    return static_cast<uint32_t>(__builtin_ctz(bits));
+   #elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, bits);
+    return static_cast<uint32_t>(index);
+   #else
+    uint32_t index = 0;
+    for (uint32_t b = bits; (b & 1) == 0; b >>= 1)
+        ++index;
+    return index;
+   #endif
+}
+
 struct ClapEventQueue
 {
   #if DISTRHO_PLUGIN_HAS_UI
@@ -127,15 +149,25 @@ struct ClapEventQueue
    #endif
   #endif
 
+    /**
+     * Parameter values shared between the audio, main and UI threads.
+     * Each value is stored atomically and then flagged in a dirty bitset (with release semantics),
+     * the UI takes a whole word of dirty bits at once (with acquire semantics) and reads the matching values.
+     * A value written while the UI is reading flags its bit again, so changes can be repeated but never lost.
+     */
     struct CachedParameters {
         uint32_t numParams;
-        bool* changed;
-        float* values;
+        uint32_t numWords;
+        std::atomic<uint32_t>* changed;
+        std::atomic<float>* values;
+        std::atomic<bool> hasChanges;
 
         CachedParameters()
             : numParams(0),
+              numWords(0),
               changed(nullptr),
-              values(nullptr) {}
+              values(nullptr),
+              hasChanges(false) {}
 
         ~CachedParameters()
         {
@@ -149,11 +181,47 @@ struct ClapEventQueue
                 return;
 
             numParams = numParameters;
-            changed = new bool[numParameters];
-            values = new float[numParameters];
+            numWords = (numParameters + 31) / 32;
+            changed = new std::atomic<uint32_t>[numWords];
+            values = new std::atomic<float>[numParameters];
+
+            for (uint32_t i=0; i<numWords; ++i)
+                changed[i].store(0, std::memory_order_relaxed);
 
-            std::memset(changed, 0, sizeof(bool)*numParameters);
-            std::memset(values, 0, sizeof(float)*numParameters);
+            for (uint32_t i=0; i<numParameters; ++i)
+                values[i].store(0.f, std::memory_order_relaxed);
+        }
+
+        float getValue(const uint32_t index) const noexcept
+        {
+            return values[index].load(std::memory_order_relaxed);
+        }
+
+        // store a new value, flagging it as changed for the UI unless @a notifyUI is false
+        void setValue(const uint32_t index, const float value, const bool notifyUI = true) noexcept
+        {
+            values[index].store(value, std::memory_order_relaxed);
+
+            if (! notifyUI)
+                return;
+
+            changed[index / 32].fetch_or(1u << (index % 32), std::memory_order_release);
+            hasChanges.store(true, std::memory_order_release);
+        }
+
+        // take and clear the changed flags of a group of 32 parameters, starting at @a word * 32
+        uint32_t takeChanged(const uint32_t word) noexcept
+        {
+            return changed[word].exchange(0, std::memory_order_acquire);
+        }
+
+        // clear all changed flags
+        void clearChanged() noexcept
+        {
+            hasChanges.store(false, std::memory_order_relaxed);
+
+            for (uint32_t i=0; i<numWords; ++i)
+                changed[i].store(0, std::memory_order_relaxed);
         }
     } fCachedParameters;
 
@@ -464,20 +532,24 @@ public:
     {
         if (UIExporter* const ui = fUI.get())
         {
+            // deliver parameter changes first, so they are handled within this idle call
+            if (fCachedParameters.hasChanges.exchange(false, std::memory_order_acquire))
+            {
+                for (uint32_t w=0; w<fCachedParameters.numWords; ++w)
+                {
+                    for (uint32_t bits = fCachedParameters.takeChanged(w); bits != 0; bits &= bits - 1)
+                    {
+                        const uint32_t i = w * 32 + countTrailingZeros(bits);
+                        ui->parameterChanged(i, fCachedParameters.getValue(i));
+                    }
+                }
+            }
+
            #if DPF_CLAP_USING_HOST_TIMER
             ui->plugin_idle();
            #else
             ui->idleFromNativeIdle();
            #endif
-
-            for (uint32_t i=0; i<fCachedParameters.numParams; ++i)
-            {
-                if (fCachedParameters.changed[i])
-                {
-                    fCachedParameters.changed[i] = false;
-                    ui->parameterChanged(i, fCachedParameters.values[i]);
-                }
-            }
         }
     }
 
@@ -536,10 +608,13 @@ private:
                              fPlugin.fPlugin,
                              fScaleFactor);
 
+        // all current values are sent below, older changes are not needed
+        fCachedParameters.clearChanged();
+
         for (uint32_t i=0; i<fCachedParameters.numParams; ++i)
         {
-            const float value = fCachedParameters.values[i] = fPlugin.getParameterValue(i);
-            fCachedParameters.changed[i] = false;
+            const float value = fPlugin.getParameterValue(i);
+            fCachedParameters.setValue(i, value, false);
             fUI->parameterChanged(i, value);
         }
 
@@ -925,6 +1000,7 @@ public:
         {
            #if DISTRHO_PLUGIN_NUM_INPUTS != 0
             const float** const audioInputs = fAudioInputs;
+            uint64_t inputSilenceMask = 0;
 
             uint32_t in=0;
             for (uint32_t i=0; i<process->audio_inputs_count; ++i)
@@ -933,9 +1009,17 @@ public:
                 DISTRHO_SAFE_ASSERT_CONTINUE(inputs.channel_count != 0);
 
                 for (uint32_t j=0; j<inputs.channel_count; ++j, ++in)
+                {
                     audioInputs[in] = const_cast<const float*>(inputs.data32[j]);
+
+                    // constant buffers with a zero value are silent
+                    if (in < 64 && j < 64 && (inputs.constant_mask & (1ULL << j)) != 0 && d_isZero(audioInputs[in][0]))
+                        inputSilenceMask |= 1ULL << in;
+                }
             }
 
+            fPlugin.setInputSilenceMask(inputSilenceMask);
+
             if (fUsingCV)
             {
                 for (; in<DISTRHO_PLUGIN_NUM_INPUTS; ++in)
@@ -985,6 +1069,24 @@ public:
             fPlugin.run(audioInputs, audioOutputs, frames);
            #endif
 
+           #if DISTRHO_PLUGIN_NUM_OUTPUTS != 0
+            // silent outputs are constant buffers for CLAP
+            const uint64_t outputSilenceMask = fPlugin.getOutputSilenceMask();
+
+            out=0;
+            for (uint32_t i=0; i<process->audio_outputs_count; ++i)
+            {
+                clap_audio_buffer_t& outputs(process->audio_outputs[i]);
+                outputs.constant_mask = 0;
+
+                for (uint32_t j=0; j<outputs.channel_count; ++j, ++out)
+                {
+                    if (out < 64 && j < 64 && (outputSilenceMask & (1ULL << out)) != 0)
+                        outputs.constant_mask |= 1ULL << j;
+                }
+            }
+           #endif
+
             flushParameters(nullptr, process->out_events, frames - 1);
 
             fOutputEvents = nullptr;
@@ -1160,11 +1262,10 @@ public:
                 {
                     value = fPlugin.getParameterValue(i);
 
-                    if (d_isEqual(fCachedParameters.values[i], value))
+                    if (d_isEqual(fCachedParameters.getValue(i), value))
                         continue;
 
-                    fCachedParameters.values[i] = value;
-                    fCachedParameters.changed[i] = true;
+                    fCachedParameters.setValue(i, value);
 
                     clapEvent.param_id = i;
                     clapEvent.value = value;
@@ -1213,8 +1314,7 @@ public:
 
     void setParameterValueFromEvent(const clap_event_param_value_t* const event)
     {
-        fCachedParameters.values[event->param_id] = event->value;
-        fCachedParameters.changed[event->param_id] = true;
+        fCachedParameters.setValue(event->param_id, event->value);
         fPlugin.setParameterValue(event->param_id, event->value);
     }
 
@@ -1501,14 +1601,8 @@ public:
                                 fvalue = std::atof(value.buffer());
                             }
 
-                            fCachedParameters.values[j] = fvalue;
-                           #if DISTRHO_PLUGIN_HAS_UI
-                            if (ui != nullptr)
-                            {
-                                // UI parameter updates are handled outside the read loop (after host param restart)
-                                fCachedParameters.changed[j] = true;
-                            }
-                           #endif
+                            // UI parameter updates are handled outside the read loop (after host param restart)
+                            fCachedParameters.setValue(j, fvalue, false);
                             fPlugin.setParameterValue(j, fvalue);
                             break;
                         }
@@ -1536,8 +1630,7 @@ public:
             {
                 if (fPlugin.isParameterOutputOrTrigger(i))
                     continue;
-                fCachedParameters.changed[i] = false;
-                ui->setParameterValueFromPlugin(i, fCachedParameters.values[i]);
+                ui->setParameterValueFromPlugin(i, fCachedParameters.getValue(i));
             }
         }
        #endif
@@ -1838,10 +1931,6 @@ private:
    #endif
 };
 
-// --------------------------------------------------------------------------------------------------------------------
-
-static ScopedPointer<PluginExporter> sPlugin;
-
 // --------------------------------------------------------------------------------------------------------------------
 // plugin gui
 
@@ -2279,6 +2368,19 @@ static uint32_t CLAP_ABI clap_get_plugin_count(const clap_plugin_factory_t*)
     return 1;
 }
 
+struct ClapVersionString {
+    char text[32];
+
+    ClapVersionString() noexcept
+    {
+        const uint32_t versionNum = plugin_getVersion();
+        std::snprintf(text, sizeof(text), "%d.%d.%d",
+                      (versionNum >> 16) & 0xff,
+                      (versionNum >> 8) & 0xff,
+                      (versionNum >> 0) & 0xff);
+    }
+};
+
 static const clap_plugin_descriptor_t* CLAP_ABI clap_get_plugin_descriptor(const clap_plugin_factory_t*,
                                                                            const uint32_t index)
 {
@@ -2295,19 +2397,21 @@ static const clap_plugin_descriptor_t* CLAP_ABI clap_get_plugin_descriptor(const
         nullptr
     };
 
+    // filled by a static initializer, which C++ guarantees to run only once even if hosts scan from many threads
+    static const ClapVersionString version;
+
+    // only uses static plugin information, hosts can scan without any plugin instance being created
     static const clap_plugin_descriptor_t descriptor = {
         CLAP_VERSION,
         DISTRHO_PLUGIN_CLAP_ID,
         plugin_getName(),
         plugin_getMaker(),
-        // TODO url
-        "",
+        plugin_getHomePage(),
         // TODO manual url
         "",
         // TODO support url
         "",
-        // TODO version string
-        "",
+        version.text,
         plugin_getDescription(),
         features
     };
@@ -2367,29 +2471,15 @@ static bool CLAP_ABI clap_plugin_entry_init(const char* const plugin_path)
     bundlePath = plugin_path;
     d_nextBundlePath = bundlePath.buffer();
 
-    // init dummy plugin
-    if (sPlugin == nullptr)
-    {
-        // set valid but dummy values
-        d_nextBufferSize = 512;
-        d_nextSampleRate = 44100.0;
-        d_nextCanRequestParameterValueChanges = true;
-
-        // Create dummy plugin to get data from
-        sPlugin = new PluginExporter(nullptr, nullptr, nullptr);
-
-        // unset
-        d_nextBufferSize = 0;
-        d_nextSampleRate = 0.0;
-        d_nextCanRequestParameterValueChanges = false;
-    }
-
+    // no plugin instance is needed here, the factory descriptor is static
     return true;
 }
 
 static void CLAP_ABI clap_plugin_entry_deinit(void)
 {
-    sPlugin = nullptr;
+   #if DISTRHO_PLUGIN_WANT_INSTANCE_POOL
+    PluginExporter::clearInstancePool();
+   #endif
 }
 
 static const void* CLAP_ABI clap_plugin_entry_get_factory(const char* const factory_id)
@@ -20,11 +20,17 @@
 #include "DistrhoPluginInfo.h"
 #include "../DistrhoPlugin.hpp"
 
+#include "../extra/Mutex.hpp"
+
+#if DISTRHO_PLUGIN_WANT_FTZ_DAZ
+# include "../extra/ScopedDenormalDisable.hpp"
+#endif
+
 #ifdef DISTRHO_PLUGIN_TARGET_VST3
 # include "DistrhoPluginVST.hpp"
 #endif
 
-#include <set>
+#include <algorithm>
 
 
 // -----------------------------------------------------------------------
@@ -39,6 +45,7 @@ extern uint32_t    d_nextBufferSize;
 extern double      d_nextSampleRate;
 extern const char* d_nextBundlePath;
 extern bool        d_nextCanRequestParameterValueChanges;
+extern bool        d_nextPluginIsDummy;
 
 // -----------------------------------------------------------------------
 // DSP callbacks
@@ -47,6 +54,20 @@ typedef bool (*writeMidiFunc) (void* ptr, const MidiEvent& midiEvent);
 typedef bool (*requestParameterValueChangeFunc) (void* ptr, uint32_t index, float value);
 typedef bool (*updateStateValueFunc) (void* ptr, const char* key, const char* value);
 
+#ifdef DPF_REALTIME_CHECKS
+// -----------------------------------------------------------------------
+// Realtime-safety checks, see DistrhoRealtimeChecker.cpp
+
+void d_enterRealtimeContext() noexcept;
+void d_leaveRealtimeContext() noexcept;
+uint32_t d_getRealtimeViolationCount() noexcept;
+
+struct ScopedRealtimeContext {
+    ScopedRealtimeContext() noexcept { d_enterRealtimeContext(); }
+    ~ScopedRealtimeContext() noexcept { d_leaveRealtimeContext(); }
+};
+#endif
+
 // -----------------------------------------------------------------------
 // Helpers
 
@@ -86,6 +107,43 @@ void fillInPredefinedPortGroupData(const uint32_t groupId, PortGroup& portGroup)
     }
 }
 
+#if DISTRHO_PLUGIN_WANT_PARAMETER_DESCRIPTORS
+static inline
+void fillInParameterFromDescriptor(const ParameterDescriptor& descriptor, Parameter& parameter)
+{
+    if (descriptor.designation != kParameterDesignationNull)
+    {
+        parameter.initDesignation(descriptor.designation);
+        return;
+    }
+
+    parameter.hints = descriptor.hints;
+    parameter.name = descriptor.name;
+    parameter.shortName = descriptor.shortName;
+    parameter.symbol = descriptor.symbol;
+    parameter.unit = descriptor.unit;
+    parameter.description = descriptor.description;
+    parameter.ranges = descriptor.ranges;
+    parameter.midiCC = descriptor.midiCC;
+    parameter.groupId = descriptor.groupId;
+
+    if (descriptor.enumCount == 0)
+        return;
+
+    ParameterEnumerationValue* const values = new ParameterEnumerationValue[descriptor.enumCount];
+
+    for (uint8_t i=0; i < descriptor.enumCount; ++i)
+    {
+        values[i].value = descriptor.enumValues[i].value;
+        values[i].label = descriptor.enumValues[i].label;
+    }
+
+    parameter.enumValues.count = descriptor.enumCount;
+    parameter.enumValues.restrictedMode = descriptor.enumRestrictedMode;
+    parameter.enumValues.values = values;
+}
+#endif
+
 static inline
 void d_strncpy(char* const dst, const char* const src, const size_t length)
 {
@@ -135,11 +193,43 @@ void snprintf_u32(char* const dst, const uint32_t value, const size_t size)
     return snprintf_t<uint32_t>(dst, value, "%u", size);
 }
 
+// -----------------------------------------------------------------------
+// Plugin shared data
+
+/**
+   Immutable plugin metadata (parameters and port groups).
+   This is identical for every instance, so it is built once per binary from the first instance that gets created
+   and shared between all instances alive at the same time.
+   Instances only keep a pointer to it, see PluginExporter::acquireSharedData().
+ */
+struct PluginSharedData {
+    uint32_t refCount;
+
+#if DISTRHO_PLUGIN_NUM_PARAMS > 0
+    Parameter parameters[DISTRHO_PLUGIN_NUM_PARAMS];
+#endif
+
+    uint32_t         portGroupCount;
+    PortGroupWithId* portGroups;
+
+    PluginSharedData() noexcept
+        : refCount(0),
+          portGroupCount(0),
+          portGroups(nullptr) {}
+
+    ~PluginSharedData() noexcept
+    {
+        delete[] portGroups;
+    }
+
+    DISTRHO_DECLARE_NON_COPYABLE(PluginSharedData)
+};
+
 // -----------------------------------------------------------------------
 // Plugin private data
 
 struct PluginPrivateData {
-    const bool canRequestParameterValueChanges;
+    bool canRequestParameterValueChanges;
     bool isProcessing;
 
 #if DISTRHO_PLUGIN_NUM_INPUTS+DISTRHO_PLUGIN_NUM_OUTPUTS > 0
@@ -148,11 +238,13 @@ struct PluginPrivateData {
 
     uint32_t   parameterOffset;
 #if DISTRHO_PLUGIN_NUM_PARAMS > 0
-    Parameter parameters[DISTRHO_PLUGIN_NUM_PARAMS];
+    // points to PluginSharedData::parameters, refcounted and shared by all instances, see PluginExporter::acquireSharedData()
+    const Parameter* parameters;
 #endif
 
-    uint32_t         portGroupCount;
-    PortGroupWithId* portGroups;
+    // points to PluginSharedData::portGroups, shared the same way as parameters
+    uint32_t               portGroupCount;
+    const PortGroupWithId* portGroups;
 
 #if DISTRHO_PLUGIN_WANT_LATENCY
     uint32_t latency;
@@ -162,6 +254,15 @@ struct PluginPrivateData {
     TimePosition timePosition;
 #endif
 
+    // Silence information for the current run() call, 1 bit per audio port (first 64 only)
+    uint64_t inputSilenceMask;
+    uint64_t outputSilenceMask;
+
+#if DISTRHO_PLUGIN_NUM_INPUTS > 0
+    // Audio inputs sharing their buffer with an audio output for the current run() call
+    bool inputsInPlace[DISTRHO_PLUGIN_NUM_INPUTS];
+#endif
+
     // Callbacks
     void*         callbacksPtr;
     writeMidiFunc writeMidiCallbackFunc;
@@ -179,11 +280,16 @@ struct PluginPrivateData {
         : canRequestParameterValueChanges(d_nextCanRequestParameterValueChanges),
           isProcessing(false),
           parameterOffset(0),
+#if DISTRHO_PLUGIN_NUM_PARAMS > 0
+          parameters(nullptr),
+#endif
           portGroupCount(0),
           portGroups(nullptr),
 #if DISTRHO_PLUGIN_WANT_LATENCY
           latency(0),
 #endif
+          inputSilenceMask(0),
+          outputSilenceMask(0),
           callbacksPtr(nullptr),
           writeMidiCallbackFunc(nullptr),
           requestParameterValueChangeCallbackFunc(nullptr),
@@ -194,6 +300,10 @@ struct PluginPrivateData {
         DISTRHO_SAFE_ASSERT(bufferSize != 0);
         DISTRHO_SAFE_ASSERT(d_isNotZero(sampleRate));
 
+#if DISTRHO_PLUGIN_NUM_INPUTS > 0
+        std::memset(inputsInPlace, 0, sizeof(inputsInPlace));
+#endif
+
 #if defined(DISTRHO_PLUGIN_TARGET_DSSI) || defined(DISTRHO_PLUGIN_TARGET_LV2)
         parameterOffset += DISTRHO_PLUGIN_NUM_INPUTS + DISTRHO_PLUGIN_NUM_OUTPUTS;
 # if DISTRHO_PLUGIN_WANT_LATENCY
@@ -217,12 +327,6 @@ struct PluginPrivateData {
 
     ~PluginPrivateData() noexcept
     {
-        if (portGroups != nullptr)
-        {
-            delete[] portGroups;
-            portGroups = nullptr;
-        }
-
         if (bundlePath != nullptr)
         {
             std::free(bundlePath);
@@ -230,6 +334,20 @@ struct PluginPrivateData {
         }
     }
 
+#if DISTRHO_PLUGIN_WANT_INSTANCE_POOL
+    // Load host state again, for pooled instances that were created ahead of time.
+    // Buffer size and sample rate are updated by PluginExporter, so the plugin gets notified about them.
+    void reloadHostState() noexcept
+    {
+        canRequestParameterValueChanges = d_nextCanRequestParameterValueChanges;
+
+        if (bundlePath != nullptr)
+            std::free(bundlePath);
+
+        bundlePath = d_nextBundlePath != nullptr ? strdup(d_nextBundlePath) : nullptr;
+    }
+#endif
+
 #if DISTRHO_PLUGIN_WANT_MIDI_OUTPUT
     bool writeMidiCallback(const MidiEvent& midiEvent)
     {
@@ -251,6 +369,118 @@ struct PluginPrivateData {
 #endif
 };
 
+#if DISTRHO_PLUGIN_WANT_INSTANCE_POOL
+// -----------------------------------------------------------------------
+// Plugin instance pool
+
+/**
+   Process-wide pool of plugin instances cloned from a single prototype, see DISTRHO_PLUGIN_WANT_INSTANCE_POOL.
+   The prototype is created on the first instantiation, spare clones only once an instance gets activated,
+   so host scans that never activate anything do not pay for them.
+   Everything is destroyed together with the last instance taken from the pool, or from the format exit hook.
+   Instances are never given back to the pool, as they are no longer pristine once used.
+   @note Nothing is destroyed during static destruction, plugin code must not run that late.
+ */
+struct PluginInstancePool {
+    Mutex    mutex;
+    void*    prototype;
+    void*    spares[DISTRHO_PLUGIN_INSTANCE_POOL_SIZE > 0 ? DISTRHO_PLUGIN_INSTANCE_POOL_SIZE : 1];
+    uint32_t spareCount;
+    uint32_t instanceCount; // taken from the pool and still alive
+
+    PluginInstancePool() noexcept
+        : prototype(nullptr),
+          spareCount(0),
+          instanceCount(0) {}
+
+    /**
+       Take a ready to use instance from the pool, or clone a new one when there are no spares left.
+     */
+    void* take()
+    {
+        const MutexLocker cml(mutex);
+
+        if (prototype == nullptr)
+        {
+            prototype = createPlugin();
+            DISTRHO_SAFE_ASSERT_RETURN(prototype != nullptr, nullptr);
+        }
+
+        void* plugin;
+
+        if (spareCount != 0)
+        {
+            plugin = spares[--spareCount];
+            getPluginPrivateData(plugin)->reloadHostState();
+        }
+        else
+        {
+            plugin = plugin_clone(prototype);
+            DISTRHO_SAFE_ASSERT_RETURN(plugin != nullptr, nullptr);
+        }
+
+        ++instanceCount;
+        return plugin;
+    }
+
+    /**
+       Create the spare instances ahead of time, called when an instance taken from the pool is activated.
+     */
+    void fill()
+    {
+        const MutexLocker cml(mutex);
+        DISTRHO_SAFE_ASSERT_RETURN(prototype != nullptr,);
+
+        while (spareCount < DISTRHO_PLUGIN_INSTANCE_POOL_SIZE)
+        {
+            void* const plugin = plugin_clone(prototype);
+            DISTRHO_SAFE_ASSERT_BREAK(plugin != nullptr);
+
+            spares[spareCount++] = plugin;
+        }
+    }
+
+    /**
+       Called after an instance taken from the pool is destroyed, the last one takes the pool down with it.
+     */
+    void release()
+    {
+        const MutexLocker cml(mutex);
+        DISTRHO_SAFE_ASSERT_RETURN(instanceCount != 0,);
+
+        if (--instanceCount == 0)
+            destroyAll();
+    }
+
+    /**
+       Destroy the prototype and spare instances, called from the format exit hooks.
+     */
+    void clear()
+    {
+        const MutexLocker cml(mutex);
+
+        // clones can share resources with the prototype, so it must outlive them
+        DISTRHO_SAFE_ASSERT_UINT_RETURN(instanceCount == 0, instanceCount,);
+
+        destroyAll();
+    }
+
+    void destroyAll()
+    {
+        while (spareCount != 0)
+            destroyPlugin(spares[--spareCount]);
+
+        if (prototype != nullptr)
+        {
+            destroyPlugin(prototype);
+            prototype = nullptr;
+        }
+    }
+
+    DISTRHO_DECLARE_NON_COPYABLE(PluginInstancePool)
+};
+#endif
+
 // -----------------------------------------------------------------------
 // Plugin exporter class
 
@@ -259,6 +489,37 @@ struct PluginExporter
     void* const fPlugin;
     PluginPrivateData* const fData;
     bool fIsActive;
+#if DISTRHO_PLUGIN_WANT_INSTANCE_POOL
+    // taken from sInstancePool, which needs to know when it goes away
+    const bool fIsPooled;
+#endif
+
+#if DISTRHO_PLUGIN_WANT_OUT_OF_PLACE_PROCESSING && DISTRHO_PLUGIN_NUM_INPUTS > 0 && DISTRHO_PLUGIN_NUM_OUTPUTS > 0
+    // Scratch space for copies of inputs that share their buffer with an output, sized to the current buffer size
+    float* fScratchBuffer;
+    uint32_t fScratchBufferSize;
+    const float* fScratchInputs[DISTRHO_PLUGIN_NUM_INPUTS];
+#endif
+
+#if DISTRHO_PLUGIN_WANT_FRAMEWORK_BYPASS
+    // Bypass owned by DPF instead of the plugin, see processBypass()
+    uint32_t fBypassIndex;
+    float    fBypassValue;
+    uint32_t fBypassFadePos;
+    uint32_t fBypassFadeLength;
+    // sin() of the fade position, fBypassFadeLength + 1 values, dry gain is [pos] and wet gain is [length - pos]
+    float*   fBypassFadeGains;
+    uint32_t fBypassWarmup;
+    bool     fBypassMixDry;
+    bool     fBypassSkipped;
+    // dry signal for the current run() call, sized to the current buffer size
+    float*   fBypassDryBuffer;
+    uint32_t fBypassDryBufferSize;
+    // history of the inputs, so the dry signal can be delayed by the plugin latency
+    float*   fBypassDelayBuffer;
+    uint32_t fBypassDelaySize;
+    uint32_t fBypassDelayPos;
+#endif
 
     // -------------------------------------------------------------------
     // Static fallback data, see DistrhoPlugin.cpp
@@ -272,9 +533,31 @@ struct PluginExporter
     PluginExporter(void* const callbacksPtr,
                    const writeMidiFunc writeMidiCall,
                    const requestParameterValueChangeFunc requestParameterValueChangeCall)
-        : fPlugin(createPlugin()),
-          fData(getPluginPrivateData(fPlugin)),
+        : fPlugin(createPluginInstance()),
+          fData(fPlugin != nullptr ? getPluginPrivateData(fPlugin) : nullptr),
           fIsActive(false)
+#if DISTRHO_PLUGIN_WANT_INSTANCE_POOL
+        , fIsPooled(fPlugin != nullptr && ! d_nextPluginIsDummy)
+#endif
+#if DISTRHO_PLUGIN_WANT_OUT_OF_PLACE_PROCESSING && DISTRHO_PLUGIN_NUM_INPUTS > 0 && DISTRHO_PLUGIN_NUM_OUTPUTS > 0
+        , fScratchBuffer(nullptr),
+          fScratchBufferSize(0)
+#endif
+#if DISTRHO_PLUGIN_WANT_FRAMEWORK_BYPASS
+        , fBypassIndex(UINT32_MAX),
+          fBypassValue(0.0f),
+          fBypassFadePos(0),
+          fBypassFadeLength(0),
+          fBypassFadeGains(nullptr),
+          fBypassWarmup(0),
+          fBypassMixDry(false),
+          fBypassSkipped(false),
+          fBypassDryBuffer(nullptr),
+          fBypassDryBufferSize(0),
+          fBypassDelayBuffer(nullptr),
+          fBypassDelaySize(0),
+          fBypassDelayPos(0)
+#endif
     {
         DISTRHO_SAFE_ASSERT_RETURN(fPlugin != nullptr,);
         DISTRHO_SAFE_ASSERT_RETURN(fData != nullptr,);
@@ -318,50 +601,72 @@ struct PluginExporter
         }
 #endif // DISTRHO_PLUGIN_NUM_INPUTS+DISTRHO_PLUGIN_NUM_OUTPUTS > 0
 
+        {
+            PluginSharedData* const sharedData = acquireSharedData(fPlugin, fData);
 #if DISTRHO_PLUGIN_NUM_PARAMS > 0
-        for (uint32_t i=0, count = DISTRHO_PLUGIN_NUM_PARAMS; i < count; ++i)
-            plugin_initParameter(fPlugin, i, fData->parameters[i]);
+            fData->parameters = sharedData->parameters;
+#endif
+            fData->portGroupCount = sharedData->portGroupCount;
+            fData->portGroups = sharedData->portGroups;
+        }
 
-        {
-            std::set<uint32_t> portGroupIndices;
+        fData->callbacksPtr = callbacksPtr;
+        fData->writeMidiCallbackFunc = writeMidiCall;
+        fData->requestParameterValueChangeCallbackFunc = requestParameterValueChangeCall;
 
-#if DISTRHO_PLUGIN_NUM_INPUTS+DISTRHO_PLUGIN_NUM_OUTPUTS > 0
-            for (uint32_t i=0; i < DISTRHO_PLUGIN_NUM_INPUTS+DISTRHO_PLUGIN_NUM_OUTPUTS; ++i)
-                portGroupIndices.insert(fData->audioPorts[i].groupId);
+#if DISTRHO_PLUGIN_WANT_OUT_OF_PLACE_PROCESSING && DISTRHO_PLUGIN_NUM_INPUTS > 0 && DISTRHO_PLUGIN_NUM_OUTPUTS > 0
+        resizeScratchBuffer(fData->bufferSize);
 #endif
-            for (uint32_t i=0, count = DISTRHO_PLUGIN_NUM_PARAMS; i < count; ++i)
-                portGroupIndices.insert(fData->parameters[i].groupId);
 
-            portGroupIndices.erase(kPortGroupNone);
-
-            if (const uint32_t portGroupSize = static_cast<uint32_t>(portGroupIndices.size()))
+#if DISTRHO_PLUGIN_WANT_FRAMEWORK_BYPASS
+        for (uint32_t i=0; i < DISTRHO_PLUGIN_NUM_PARAMS; ++i)
+        {
+            if (fData->parameters[i].designation == kParameterDesignationBypass)
             {
-                fData->portGroups = new PortGroupWithId[portGroupSize];
-                fData->portGroupCount = portGroupSize;
-
-                uint32_t index = 0;
-                for (std::set<uint32_t>::iterator it = portGroupIndices.begin(); it != portGroupIndices.end(); ++it, ++index)
-                {
-                    PortGroupWithId& portGroup(fData->portGroups[index]);
-                    portGroup.groupId = *it;
-
-                    if (portGroup.groupId < portGroupSize)
-                        plugin_initPortGroup(fPlugin, portGroup.groupId, portGroup);
-                    else
-                        fillInPredefinedPortGroupData(portGroup.groupId, portGroup);
-                }
+                fBypassIndex = i;
+                fBypassValue = fData->parameters[i].ranges.defaultValue;
+                break;
             }
         }
-#endif // DISTRHO_PLUGIN_NUM_PARAMS > 0
 
-        fData->callbacksPtr = callbacksPtr;
-        fData->writeMidiCallbackFunc = writeMidiCall;
-        fData->requestParameterValueChangeCallbackFunc = requestParameterValueChangeCall;
+        // designations are only known once parameters are initialized, this cannot be checked at compile time
+        if (fBypassIndex == UINT32_MAX)
+            d_stderr2("DISTRHO_PLUGIN_WANT_FRAMEWORK_BYPASS is enabled but no parameter uses kParameterDesignationBypass");
+
+        resizeBypassDryBuffer(fData->bufferSize);
+        updateBypassFadeLength();
+#endif
+
+#if DISTRHO_PLUGIN_WANT_INSTANCE_POOL
+        // pooled instances still have the buffer size and sample rate of the first instantiation
+        if (d_nextBufferSize != 0)
+            setBufferSize(d_nextBufferSize, true);
+        if (d_isNotZero(d_nextSampleRate))
+            setSampleRate(d_nextSampleRate, true);
+#endif
     }
 
     ~PluginExporter()
     {
         destroyPlugin(fPlugin);
+
+#if DISTRHO_PLUGIN_WANT_INSTANCE_POOL
+        if (fIsPooled)
+            sInstancePool.release();
+#endif
+
+#if DISTRHO_PLUGIN_WANT_OUT_OF_PLACE_PROCESSING && DISTRHO_PLUGIN_NUM_INPUTS > 0 && DISTRHO_PLUGIN_NUM_OUTPUTS > 0
+        delete[] fScratchBuffer;
+#endif
+
+#if DISTRHO_PLUGIN_WANT_FRAMEWORK_BYPASS
+        delete[] fBypassDryBuffer;
+        delete[] fBypassDelayBuffer;
+        delete[] fBypassFadeGains;
+#endif
+
+        if (fPlugin != nullptr && fData != nullptr)
+            releaseSharedData();
     }
 
     // -------------------------------------------------------------------
@@ -559,6 +864,11 @@ struct PluginExporter
         DISTRHO_SAFE_ASSERT_RETURN(fPlugin != nullptr, 0.0f);
         DISTRHO_SAFE_ASSERT_RETURN(fData != nullptr && index < DISTRHO_PLUGIN_NUM_PARAMS, 0.0f);
 
+#if DISTRHO_PLUGIN_WANT_FRAMEWORK_BYPASS
+        if (index == fBypassIndex)
+            return fBypassValue;
+#endif
+
         return plugin_getParameterValue(fPlugin, index);
     }
 
@@ -567,6 +877,14 @@ struct PluginExporter
         DISTRHO_SAFE_ASSERT_RETURN(fPlugin != nullptr,);
         DISTRHO_SAFE_ASSERT_RETURN(fData != nullptr && index < DISTRHO_PLUGIN_NUM_PARAMS,);
 
+#if DISTRHO_PLUGIN_WANT_FRAMEWORK_BYPASS
+        if (index == fBypassIndex)
+        {
+            fBypassValue = value;
+            return;
+        }
+#endif
+
         plugin_setParameterValue(fPlugin, index, value);
     }
 
@@ -615,6 +933,27 @@ struct PluginExporter
     }
 #endif
 
+    /*
+     * Set the mask of silent inputs for the next run() call, as provided by the host.
+     * Automatically reset to 0 after each run().
+     */
+    void setInputSilenceMask(const uint64_t mask) noexcept
+    {
+        DISTRHO_SAFE_ASSERT_RETURN(fData != nullptr,);
+
+        fData->inputSilenceMask = mask;
+    }
+
+    /*
+     * Get the mask of silent outputs reported by the plugin during the last run() call.
+     */
+    uint64_t getOutputSilenceMask() const noexcept
+    {
+        DISTRHO_SAFE_ASSERT_RETURN(fData != nullptr, 0);
+
+        return fData->outputSilenceMask;
+    }
+
     // -------------------------------------------------------------------
 
     void activate()
@@ -624,6 +963,16 @@ struct PluginExporter
 
         fIsActive = true;
         plugin_activate(fPlugin);
+
+#if DISTRHO_PLUGIN_WANT_INSTANCE_POOL
+        // only instances that are really used make it worth having spares around
+        if (fIsPooled)
+            sInstancePool.fill();
+#endif
+
+#if DISTRHO_PLUGIN_WANT_FRAMEWORK_BYPASS
+        resetBypass();
+#endif
     }
 
     void deactivate()
@@ -657,11 +1006,42 @@ struct PluginExporter
         {
             fIsActive = true;
             plugin_activate(fPlugin);
+#if DISTRHO_PLUGIN_WANT_FRAMEWORK_BYPASS
+            resetBypass();
+#endif
         }
 
+       #ifdef DPF_REALTIME_CHECKS
+        const ScopedRealtimeContext src;
+       #endif
+       #if DISTRHO_PLUGIN_WANT_FTZ_DAZ
+        const ScopedDenormalDisable sdd;
+       #endif
+
+#if DISTRHO_PLUGIN_WANT_FRAMEWORK_BYPASS
+        const bool bypassed = prepareBypass(inputs, frames);
+
+        // fully bypassed, the plugin only needs to run to receive MIDI events, so notes do not get stuck
+        if (bypassed && midiEventCount == 0)
+        {
+            fData->outputSilenceMask = 0;
+            fData->inputSilenceMask = 0;
+            processBypass(outputs, frames, true);
+            return;
+        }
+#endif
+
+        const float** const runInputs = prepareInputs(inputs, outputs, frames);
+
         fData->isProcessing = true;
-        plugin_run(fPlugin, inputs, outputs, frames, midiEvents, midiEventCount);
+        fData->outputSilenceMask = 0;
+        plugin_run(fPlugin, runInputs, outputs, frames, midiEvents, midiEventCount);
         fData->isProcessing = false;
+        fData->inputSilenceMask = 0;
+
+#if DISTRHO_PLUGIN_WANT_FRAMEWORK_BYPASS
+        processBypass(outputs, frames, bypassed);
+#endif
     }
 #else
     void run(const float** const inputs, float** const outputs, const uint32_t frames)
@@ -673,11 +1053,40 @@ struct PluginExporter
         {
             fIsActive = true;
             plugin_activate(fPlugin);
+#if DISTRHO_PLUGIN_WANT_FRAMEWORK_BYPASS
+            resetBypass();
+#endif
         }
 
+       #ifdef DPF_REALTIME_CHECKS
+        const ScopedRealtimeContext src;
+       #endif
+       #if DISTRHO_PLUGIN_WANT_FTZ_DAZ
+        const ScopedDenormalDisable sdd;
+       #endif
+
+#if DISTRHO_PLUGIN_WANT_FRAMEWORK_BYPASS
+        // fully bypassed, the plugin does not need to run at all
+        if (prepareBypass(inputs, frames))
+        {
+            fData->outputSilenceMask = 0;
+            fData->inputSilenceMask = 0;
+            processBypass(outputs, frames, true);
+            return;
+        }
+#endif
+
+        const float** const runInputs = prepareInputs(inputs, outputs, frames);
+
         fData->isProcessing = true;
-        plugin_run(fPlugin, inputs, outputs, frames);
+        fData->outputSilenceMask = 0;
+        plugin_run(fPlugin, runInputs, outputs, frames);
         fData->isProcessing = false;
+        fData->inputSilenceMask = 0;
+
+#if DISTRHO_PLUGIN_WANT_FRAMEWORK_BYPASS
+        processBypass(outputs, frames, false);
+#endif
     }
 #endif
 
@@ -706,6 +1115,13 @@ struct PluginExporter
 
         fData->bufferSize = bufferSize;
 
+#if DISTRHO_PLUGIN_WANT_OUT_OF_PLACE_PROCESSING && DISTRHO_PLUGIN_NUM_INPUTS > 0 && DISTRHO_PLUGIN_NUM_OUTPUTS > 0
+        resizeScratchBuffer(bufferSize);
+#endif
+#if DISTRHO_PLUGIN_WANT_FRAMEWORK_BYPASS
+        resizeBypassDryBuffer(bufferSize);
+#endif
+
         if (doCallback)
         {
             if (fIsActive) plugin_deactivate(fPlugin);
@@ -725,6 +1141,10 @@ struct PluginExporter
 
         fData->sampleRate = sampleRate;
 
+#if DISTRHO_PLUGIN_WANT_FRAMEWORK_BYPASS
+        updateBypassFadeLength();
+#endif
+
         if (doCallback)
         {
             if (fIsActive) plugin_deactivate(fPlugin);
@@ -733,7 +1153,421 @@ struct PluginExporter
         }
     }
 
+#if DISTRHO_PLUGIN_WANT_INSTANCE_POOL
+    // -------------------------------------------------------------------
+    // To be called from the format exit hook, once all instances are gone
+
+    static void clearInstancePool()
+    {
+        sInstancePool.clear();
+    }
+#endif
+
 private:
+    // -------------------------------------------------------------------
+    // In-place processing
+
+    /*
+     * Find out which inputs share their buffer with an output, updating PluginPrivateData::inputsInPlace.
+     * When out-of-place processing is requested, those inputs are copied into scratch buffers first.
+     * Returns the inputs to pass into plugin_run().
+     */
+    const float** prepareInputs(const float** const inputs, float** const outputs, const uint32_t frames) noexcept
+    {
+#if DISTRHO_PLUGIN_NUM_INPUTS > 0 && DISTRHO_PLUGIN_NUM_OUTPUTS > 0
+        if (inputs == nullptr || outputs == nullptr)
+            return inputs;
+
+# if DISTRHO_PLUGIN_WANT_OUT_OF_PLACE_PROCESSING
+        // hosts must not go over the buffer size, but do not write out of bounds if they do
+        const bool canCopy = frames <= fScratchBufferSize;
+        DISTRHO_SAFE_ASSERT_UINT2(canCopy, frames, fScratchBufferSize);
+# endif
+
+        for (uint32_t i=0; i < DISTRHO_PLUGIN_NUM_INPUTS; ++i)
+        {
+            bool inPlace = false;
+
+            if (inputs[i] != nullptr)
+            {
+                for (uint32_t j=0; j < DISTRHO_PLUGIN_NUM_OUTPUTS; ++j)
+                {
+                    if (inputs[i] == outputs[j])
+                    {
+                        inPlace = true;
+                        break;
+                    }
+                }
+            }
+
+# if DISTRHO_PLUGIN_WANT_OUT_OF_PLACE_PROCESSING
+            fScratchInputs[i] = inputs[i];
+
+            if (inPlace && canCopy)
+            {
+                float* const scratch = fScratchBuffer + i * fScratchBufferSize;
+                std::memcpy(scratch, inputs[i], sizeof(float) * frames);
+                fScratchInputs[i] = scratch;
+                inPlace = false;
+            }
+# endif
+
+            fData->inputsInPlace[i] = inPlace;
+        }
+
+# if DISTRHO_PLUGIN_WANT_OUT_OF_PLACE_PROCESSING
+        return fScratchInputs;
+# endif
+#endif
+
+        // unused
+        (void)outputs;
+        (void)frames;
+
+        return inputs;
+    }
+
+#if DISTRHO_PLUGIN_WANT_OUT_OF_PLACE_PROCESSING && DISTRHO_PLUGIN_NUM_INPUTS > 0 && DISTRHO_PLUGIN_NUM_OUTPUTS > 0
+    void resizeScratchBuffer(const uint32_t bufferSize)
+    {
+        if (fScratchBufferSize == bufferSize)
+            return;
+
+        delete[] fScratchBuffer;
+        fScratchBuffer = new float[DISTRHO_PLUGIN_NUM_INPUTS * bufferSize];
+        fScratchBufferSize = bufferSize;
+    }
+#endif
+
+#if DISTRHO_PLUGIN_WANT_FRAMEWORK_BYPASS
+    // -------------------------------------------------------------------
+    // Framework bypass
+
+    void resizeBypassDryBuffer(const uint32_t bufferSize)
+    {
+        if (fBypassDryBufferSize == bufferSize)
+            return;
+
+        delete[] fBypassDryBuffer;
+        fBypassDryBuffer = new float[DISTRHO_PLUGIN_NUM_INPUTS * bufferSize];
+        fBypassDryBufferSize = bufferSize;
+    }
+
+    void updateBypassFadeLength()
+    {
+        const double frames = fData->sampleRate * DISTRHO_PLUGIN_BYPASS_FADE_TIME / 1000.0;
+        const uint32_t length = frames >= 1.0 ? static_cast<uint32_t>(frames + 0.5) : 1;
+
+        if (fBypassFadeLength == length)
+            return;
+
+        // equal-power gains for every fade position, so run() does not need any trigonometry
+        delete[] fBypassFadeGains;
+        fBypassFadeGains = new float[length + 1];
+
+        for (uint32_t i=0; i <= length; ++i)
+            fBypassFadeGains[i] = static_cast<float>(std::sin(M_PI_2 * i / length));
+
+        fBypassFadeLength = length;
+        fBypassFadePos = std::min(fBypassFadePos, fBypassFadeLength);
+    }
+
+    /*
+     * Called on activation, clears the dry signal history and jumps to the current bypass state.
+     * The delay line is sized here for the current latency, as activation is allowed to allocate.
+     */
+    void resetBypass()
+    {
+       #if DISTRHO_PLUGIN_WANT_LATENCY
+        const uint32_t latency = fData->latency;
+       #else
+        const uint32_t latency = 0;
+       #endif
+
+        if (latency != 0 && fBypassDelaySize <= latency)
+        {
+            uint32_t size = 1;
+            while (size <= latency)
+                size *= 2;
+
+            delete[] fBypassDelayBuffer;
+            fBypassDelayBuffer = new float[DISTRHO_PLUGIN_NUM_INPUTS * size];
+            fBypassDelaySize = size;
+        }
+
+        if (fBypassDelayBuffer != nullptr)
+            std::memset(fBypassDelayBuffer, 0, sizeof(float) * DISTRHO_PLUGIN_NUM_INPUTS * fBypassDelaySize);
+
+        fBypassDelayPos = 0;
+        fBypassFadePos = fBypassValue > 0.5f ? fBypassFadeLength : 0;
+        fBypassWarmup = 0;
+        fBypassSkipped = false;
+    }
+
+    /*
+     * Prepare the dry signal for the current run() call, which must happen before the plugin overwrites in-place inputs.
+     * The dry signal is the input delayed by the plugin latency, so it lines up with the processed signal.
+     * Returns true when fully bypassed, in which case the plugin does not need to run.
+     */
+    bool prepareBypass(const float** const inputs, const uint32_t frames) noexcept
+    {
+        fBypassMixDry = false;
+
+        if (fBypassIndex == UINT32_MAX || inputs == nullptr)
+            return false;
+
+        // hosts must not go over the buffer size, run the plugin without bypass handling if they do
+        DISTRHO_SAFE_ASSERT_UINT2_RETURN(frames <= fBypassDryBufferSize, frames, fBypassDryBufferSize, false);
+
+       #if DISTRHO_PLUGIN_WANT_LATENCY
+        // latency can change during run(), but the delay line is only resized on activation
+        const uint32_t latency = std::min(fData->latency, fBypassDelaySize != 0 ? fBypassDelaySize - 1 : 0);
+       #else
+        const uint32_t latency = 0;
+       #endif
+        const uint32_t mask = fBypassDelaySize - 1;
+
+        fBypassMixDry = fBypassFadePos != 0 || fBypassValue > 0.5f;
+
+        for (uint32_t c=0; c < DISTRHO_PLUGIN_NUM_INPUTS; ++c)
+        {
+            const float* const input = inputs[c];
+            float* const delay = fBypassDelayBuffer + c * fBypassDelaySize;
+
+            if (fBypassMixDry)
+            {
+                float* const dry = fBypassDryBuffer + c * fBypassDryBufferSize;
+                const uint32_t fromHistory = std::min(latency, frames);
+
+                for (uint32_t i=0; i < fromHistory; ++i)
+                    dry[i] = delay[(fBypassDelayPos - latency + i) & mask];
+
+                if (input != nullptr)
+                    std::memcpy(dry + fromHistory, input, sizeof(float) * (frames - fromHistory));
+                else
+                    std::memset(dry + fromHistory, 0, sizeof(float) * (frames - fromHistory));
+            }
+
+            // keep the input history, only the most recent samples are ever needed
+            if (latency != 0)
+            {
+                const uint32_t first = frames > fBypassDelaySize ? frames - fBypassDelaySize : 0;
+
+                for (uint32_t i=first; i < frames; ++i)
+                    delay[(fBypassDelayPos + i) & mask] = input != nullptr ? input[i] : 0.0f;
+            }
+        }
+
+        if (latency != 0)
+            fBypassDelayPos = (fBypassDelayPos + frames) & mask;
+
+        const bool skip = fBypassMixDry && fBypassValue > 0.5f && fBypassFadePos == fBypassFadeLength;
+
+        // the plugin missed audio while skipped, let it fill its latency with new audio before fading back to it
+        if (fBypassSkipped && ! skip)
+            fBypassWarmup = latency;
+
+        fBypassSkipped = skip;
+        return skip;
+    }
+
+    /*
+     * Write the dry signal into the outputs, either fully (when bypassed) or as an equal-power cross-fade.
+     * When fully bypassed the plugin might still have run to receive MIDI, its output is replaced.
+     * Outputs beyond the number of inputs get the dry signal of the last input.
+     */
+    void processBypass(float** const outputs, const uint32_t frames, const bool bypassed) noexcept
+    {
+        if (! fBypassMixDry || outputs == nullptr)
+            return;
+
+        if (bypassed)
+        {
+            for (uint32_t c=0; c < DISTRHO_PLUGIN_NUM_OUTPUTS; ++c)
+            {
+                const uint32_t dryIndex = std::min<uint32_t>(c, DISTRHO_PLUGIN_NUM_INPUTS - 1);
+                std::memcpy(outputs[c], fBypassDryBuffer + dryIndex * fBypassDryBufferSize, sizeof(float) * frames);
+            }
+            return;
+        }
+
+        const bool fadeOut = fBypassValue > 0.5f;
+
+        for (uint32_t i=0; i < frames; ++i)
+        {
+            if (fadeOut)
+            {
+                fBypassWarmup = 0;
+
+                if (fBypassFadePos < fBypassFadeLength)
+                    ++fBypassFadePos;
+            }
+            else if (fBypassWarmup != 0)
+            {
+                --fBypassWarmup;
+            }
+            else if (fBypassFadePos != 0)
+            {
+                --fBypassFadePos;
+            }
+
+            const float wetGain = fBypassFadeGains[fBypassFadeLength - fBypassFadePos];
+            const float dryGain = fBypassFadeGains[fBypassFadePos];
+
+            for (uint32_t c=0; c < DISTRHO_PLUGIN_NUM_OUTPUTS; ++c)
+            {
+                const uint32_t dryIndex = std::min<uint32_t>(c, DISTRHO_PLUGIN_NUM_INPUTS - 1);
+                const float dry = fBypassDryBuffer[dryIndex * fBypassDryBufferSize + i];
+                outputs[c][i] = outputs[c][i] * wetGain + dry * dryGain;
+            }
+        }
+    }
+#endif
+
+    // -------------------------------------------------------------------
+    // Instance creation
+
+#if DISTRHO_PLUGIN_WANT_INSTANCE_POOL
+    static PluginInstancePool sInstancePool;
+#endif
+
+    static void* createPluginInstance()
+    {
+#if DISTRHO_PLUGIN_WANT_INSTANCE_POOL
+        // dummy instances only provide plugin information, no need to fill the pool for them
+        if (d_nextPluginIsDummy)
+            return createPlugin();
+
+        return sInstancePool.take();
+#else
+        return createPlugin();
+#endif
+    }
+
+    // -------------------------------------------------------------------
+    // Shared data, see DistrhoPlugin.cpp
+
+    static PluginSharedData* sSharedData;
+    static Mutex             sSharedDataMutex;
+
+    /**
+       Get the process-wide plugin metadata, building it from @a plugin if this is the first instance.
+       Every call must be matched by a releaseSharedData() call.
+     */
+    static PluginSharedData* acquireSharedData(void* const plugin, PluginPrivateData* const data)
+    {
+        const MutexLocker cml(sSharedDataMutex);
+
+        if (sSharedData != nullptr)
+        {
+            ++sSharedData->refCount;
+            return sSharedData;
+        }
+
+#if DISTRHO_PLUGIN_WANT_PARAMETER_DESCRIPTORS
+        // only depends on static data, so it is built once and kept for the lifetime of the binary
+        static PluginSharedData staticSharedData;
+        PluginSharedData* const sharedData = &staticSharedData;
+        sharedData->refCount = 1;
+
+        for (uint32_t i=0, count = DISTRHO_PLUGIN_NUM_PARAMS; i < count; ++i)
+            fillInParameterFromDescriptor(kPluginParameterDescriptors[i], sharedData->parameters[i]);
+#else
+        PluginSharedData* const sharedData = new PluginSharedData();
+        sharedData->refCount = 1;
+
+# if DISTRHO_PLUGIN_NUM_PARAMS > 0
+        for (uint32_t i=0, count = DISTRHO_PLUGIN_NUM_PARAMS; i < count; ++i)
+            plugin_initParameter(plugin, i, sharedData->parameters[i]);
+# endif
+#endif
+
+#if DISTRHO_PLUGIN_NUM_PARAMS > 0
+        // collect unique port group ids, sorted
+        uint32_t portGroupIds[DISTRHO_PLUGIN_NUM_INPUTS+DISTRHO_PLUGIN_NUM_OUTPUTS+DISTRHO_PLUGIN_NUM_PARAMS];
+        uint32_t portGroupIdCount = 0;
+
+# if DISTRHO_PLUGIN_NUM_INPUTS+DISTRHO_PLUGIN_NUM_OUTPUTS > 0
+        for (uint32_t i=0; i < DISTRHO_PLUGIN_NUM_INPUTS+DISTRHO_PLUGIN_NUM_OUTPUTS; ++i)
+        {
+            if (data->audioPorts[i].groupId != kPortGroupNone)
+                portGroupIds[portGroupIdCount++] = data->audioPorts[i].groupId;
+        }
+# endif
+        for (uint32_t i=0, count = DISTRHO_PLUGIN_NUM_PARAMS; i < count; ++i)
+        {
+            if (sharedData->parameters[i].groupId != kPortGroupNone)
+                portGroupIds[portGroupIdCount++] = sharedData->parameters[i].groupId;
+        }
+
+        // insertion sort that drops duplicates, group counts are small
+        {
+            uint32_t uniqueCount = 0;
+
+            for (uint32_t i=0; i < portGroupIdCount; ++i)
+            {
+                const uint32_t groupId = portGroupIds[i];
+                uint32_t pos = uniqueCount;
+
+                while (pos != 0 && portGroupIds[pos - 1] > groupId)
+                    --pos;
+
+                if (pos != 0 && portGroupIds[pos - 1] == groupId)
+                    continue;
+
+                std::memmove(portGroupIds + pos + 1, portGroupIds + pos, sizeof(uint32_t) * (uniqueCount - pos));
+                portGroupIds[pos] = groupId;
+                ++uniqueCount;
+            }
+
+            portGroupIdCount = uniqueCount;
+        }
+
+        if (const uint32_t portGroupSize = portGroupIdCount)
+        {
+            sharedData->portGroups = new PortGroupWithId[portGroupSize];
+            sharedData->portGroupCount = portGroupSize;
+
+            for (uint32_t index = 0; index < portGroupSize; ++index)
+            {
+                PortGroupWithId& portGroup(sharedData->portGroups[index]);
+                portGroup.groupId = portGroupIds[index];
+
+                if (portGroup.groupId < portGroupSize)
+                    plugin_initPortGroup(plugin, portGroup.groupId, portGroup);
+                else
+                    fillInPredefinedPortGroupData(portGroup.groupId, portGroup);
+            }
+        }
+#else
+        // unused
+        (void)plugin;
+        (void)data;
+#endif // DISTRHO_PLUGIN_NUM_PARAMS > 0
+
+        return sSharedData = sharedData;
+    }
+
+    /**
+       Release the process-wide plugin metadata, deleting it if this was the last instance.
+     */
+    static void releaseSharedData()
+    {
+        const MutexLocker cml(sSharedDataMutex);
+        DISTRHO_SAFE_ASSERT_RETURN(sSharedData != nullptr,);
+
+        if (--sSharedData->refCount != 0)
+            return;
+
+#if DISTRHO_PLUGIN_WANT_PARAMETER_DESCRIPTORS
+        // static data, kept around for the next instance
+        ++sSharedData->refCount;
+#else
+        delete sSharedData;
+        sSharedData = nullptr;
+#endif
+    }
+
     DISTRHO_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PluginExporter)
 };
 
@@ -0,0 +1,430 @@
+/*
+ * DISTRHO Plugin Framework (DPF)
+ * Copyright (C) 2012-2023 Filipe Coelho <falktx@falktx.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any purpose with
+ * or without fee is hereby granted, provided that the above copyright notice and this
+ * permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+ * TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+ * NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+ * IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Headless test host.
+ *
+ * Links the plugin DSP against a fake host that drives it through many activate/run/parameter/MIDI sequences,
+ * using random block sizes, sample rates and in-place buffers, while checking that the plugin:
+ *  - never outputs NaN or infinite values (audio and output parameters)
+ *  - does not allocate or take locks inside run(), as reported by the realtime-safety checker
+ *  - does not produce denormals (reported as a warning, as most hosts enable flush-to-zero)
+ * Processing time statistics are printed at the end of each configuration.
+ *
+ * Usage: ./plugin-test [blocks-per-configuration] [random-seed]
+ * Exits with a non-zero status if any check fails.
+ */
+
+#include "DistrhoPluginInternal.hpp"
+
+#include <chrono>
+
+#ifndef DPF_REALTIME_CHECKS
+# error The test host requires DPF_REALTIME_CHECKS
+#endif
+
+// --------------------------------------------------------------------------------------------------------------------
+// Float checks, done on the bit representation so they keep working under -ffast-math
+
+static inline
+uint32_t floatBits(const float value) noexcept
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static inline
+bool isNotFinite(const float value) noexcept
+{
+    return (floatBits(value) & 0x7f800000) == 0x7f800000;
+}
+
+static inline
+bool isDenormal(const float value) noexcept
+{
+    const uint32_t bits = floatBits(value);
+    return (bits & 0x7f800000) == 0 && (bits & 0x007fffff) != 0;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Deterministic random numbers, so failures can be reproduced with the same seed
+
+class Random
+{
+public:
+    explicit Random(const uint32_t seed) noexcept
+        : state(seed != 0 ? seed : 0x12345678) {}
+
+    uint32_t next() noexcept
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    // value in [0, max)
+    uint32_t next(const uint32_t max) noexcept
+    {
+        return next() % max;
+    }
+
+    // value in [0, 1)
+    float nextFloat() noexcept
+    {
+        return static_cast<float>(next() >> 8) / 16777216.0f;
+    }
+
+    bool chance(const uint32_t oneIn) noexcept
+    {
+        return next(oneIn) == 0;
+    }
+
+private:
+    uint32_t state;
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+class PluginTestHost
+{
+public:
+    PluginTestHost(const uint32_t blocksPerConfig, const uint32_t seed)
+        : fPlugin(this, writeMidiCallback, requestParameterValueChangeCallback),
+          fRandom(seed),
+          fBlocksPerConfig(blocksPerConfig),
+          fFailures(0),
+          fMidiOutputCount(0)
+    {
+    }
+
+    bool run()
+    {
+        d_stdout("Testing '%s' (%s)", plugin_getName(), plugin_getLabel());
+
+        checkParameterDetails();
+
+        static const uint32_t bufferSizes[] = { 64, 512, 4096 };
+        static const double sampleRates[] = { 44100.0, 48000.0, 96000.0 };
+
+        for (uint32_t b = 0; b < ARRAY_SIZE(bufferSizes); ++b)
+        {
+            for (uint32_t s = 0; s < ARRAY_SIZE(sampleRates); ++s)
+                runConfiguration(bufferSizes[b], sampleRates[s]);
+        }
+
+        if (fFailures != 0)
+            d_stderr2("FAILED, %u check(s) failed for '%s'", fFailures, plugin_getName());
+        else
+            d_stdout("OK");
+
+        return fFailures == 0;
+    }
+
+private:
+    PluginExporter fPlugin;
+    Random fRandom;
+
+    const uint32_t fBlocksPerConfig;
+    uint32_t fFailures;
+    uint32_t fMidiOutputCount;
+
+    void fail(const char* const message, const uint32_t arg1 = 0, const uint32_t arg2 = 0)
+    {
+        // a broken plugin usually fails the same check on every block, only show the first few
+        if (++fFailures <= 20)
+            d_stderr2("  check failed: %s (%u, %u)", message, arg1, arg2);
+        else if (fFailures == 21)
+            d_stderr2("  further failures not shown...");
+    }
+
+    // ----------------------------------------------------------------------------------------------------------------
+
+    void checkParameterDetails()
+    {
+        for (uint32_t i = 0, count = fPlugin.getParameterCount(); i < count; ++i)
+        {
+            const ParameterRanges& ranges(fPlugin.getParameterRanges(i));
+
+            if (fPlugin.getParameterSymbol(i).isEmpty())
+                fail("parameter has no symbol", i);
+            if (! (ranges.min < ranges.max))
+                fail("parameter range is empty or inverted", i);
+            if (ranges.defaultValue < ranges.min || ranges.defaultValue > ranges.max)
+                fail("parameter default is out of range", i);
+        }
+    }
+
+    // ----------------------------------------------------------------------------------------------------------------
+
+    void runConfiguration(const uint32_t bufferSize, const double sampleRate)
+    {
+        fPlugin.setBufferSize(bufferSize, true);
+        fPlugin.setSampleRate(sampleRate, true);
+
+        // plain variables instead of macros, avoids warnings about always-false comparisons without audio ports
+        const uint32_t numInputs = DISTRHO_PLUGIN_NUM_INPUTS;
+        const uint32_t numOutputs = DISTRHO_PLUGIN_NUM_OUTPUTS;
+
+        // allocate everything ahead of time, nothing must allocate while processing
+        const uint32_t numBuffers = numInputs + numOutputs;
+        float* const audioBuffer = new float[(numBuffers > 0 ? numBuffers : 1) * bufferSize];
+
+       #if DISTRHO_PLUGIN_NUM_INPUTS > 0
+        const float* inputs[DISTRHO_PLUGIN_NUM_INPUTS];
+       #else
+        const float** const inputs = nullptr;
+       #endif
+       #if DISTRHO_PLUGIN_NUM_OUTPUTS > 0
+        float* outputs[DISTRHO_PLUGIN_NUM_OUTPUTS];
+       #else
+        float** const outputs = nullptr;
+       #endif
+       #if DISTRHO_PLUGIN_WANT_MIDI_INPUT
+        MidiEvent midiEvents[kMaxMidiEvents];
+        bool notesOn[128] = {};
+       #endif
+       #if DISTRHO_PLUGIN_WANT_TIMEPOS
+        TimePosition timePosition;
+       #endif
+
+        uint64_t totalFrames = 0;
+        uint64_t totalNanoseconds = 0;
+        uint64_t maxBlockNanosecondsPerFrame = 0;
+        uint32_t denormalBlocks = 0;
+        float phase = 0.0f;
+
+        fPlugin.activate();
+
+        for (uint32_t block = 0; block < fBlocksPerConfig; ++block)
+        {
+            // every now and then, restart processing
+            if (fRandom.chance(64))
+            {
+                fPlugin.deactivate();
+                fPlugin.activate();
+            }
+
+            const uint32_t frames = fRandom.chance(4) ? bufferSize : 1 + fRandom.next(bufferSize);
+
+            // generate input signal
+            const uint32_t signalType = fRandom.next(4);
+            const float frequency = 20.0f + fRandom.nextFloat() * 8000.0f;
+
+            for (uint32_t c = 0; c < numInputs; ++c)
+            {
+                float* const buffer = audioBuffer + c * bufferSize;
+
+                for (uint32_t i = 0; i < frames; ++i)
+                {
+                    switch (signalType)
+                    {
+                    case 0: // silence
+                        buffer[i] = 0.0f;
+                        break;
+                    case 1: // noise
+                        buffer[i] = fRandom.nextFloat() * 2.0f - 1.0f;
+                        break;
+                    case 2: // sine
+                        buffer[i] = std::sin(phase + 2.0f * static_cast<float>(M_PI) * frequency * i / sampleRate);
+                        break;
+                    default: // impulse followed by silence, the usual source of denormals in feedback paths
+                        buffer[i] = i == 0 ? 1.0f : 0.0f;
+                        break;
+                    }
+                }
+
+                inputs[c] = buffer;
+            }
+
+            phase = std::fmod(phase + 2.0f * static_cast<float>(M_PI) * frequency * frames / sampleRate,
+                              2.0f * static_cast<float>(M_PI));
+
+            // outputs, sometimes sharing buffers with inputs like many hosts do
+            const bool inPlace = numInputs != 0 && fRandom.chance(4);
+
+            for (uint32_t c = 0; c < numOutputs; ++c)
+            {
+                if (inPlace && c < numInputs)
+                {
+                    outputs[c] = audioBuffer + c * bufferSize;
+                }
+                else
+                {
+                    outputs[c] = audioBuffer + (numInputs + c) * bufferSize;
+                    std::memset(outputs[c], 0, sizeof(float) * frames);
+                }
+            }
+
+            // random parameter changes
+            for (uint32_t i = 0, count = fPlugin.getParameterCount(); i < count; ++i)
+            {
+                if (fPlugin.isParameterOutput(i) || ! fRandom.chance(8))
+                    continue;
+
+                const ParameterRanges& ranges(fPlugin.getParameterRanges(i));
+                const uint32_t hints = fPlugin.getParameterHints(i);
+                float value = ranges.min + fRandom.nextFloat() * (ranges.max - ranges.min);
+
+                if (hints & kParameterIsBoolean)
+                    value = fRandom.chance(2) ? ranges.max : ranges.min;
+                else if (hints & kParameterIsInteger)
+                    value = std::round(value);
+
+                fPlugin.setParameterValue(i, value);
+            }
+
+           #if DISTRHO_PLUGIN_WANT_MIDI_INPUT
+            // random notes, sorted by frame
+            uint32_t midiEventCount = 0;
+
+            for (uint32_t frame = 0; frame < frames && midiEventCount < kMaxMidiEvents; frame += 1 + fRandom.next(64))
+            {
+                if (! fRandom.chance(8))
+                    continue;
+
+                const uint8_t note = static_cast<uint8_t>(fRandom.next(128));
+                MidiEvent& event(midiEvents[midiEventCount++]);
+                event.frame = frame;
+                event.size = 3;
+                event.data[0] = notesOn[note] ? 0x80 : 0x90;
+                event.data[1] = note;
+                event.data[2] = notesOn[note] ? 0 : static_cast<uint8_t>(1 + fRandom.next(127));
+                event.data[3] = 0;
+                event.dataExt = nullptr;
+                notesOn[note] = ! notesOn[note];
+            }
+           #endif
+
+           #if DISTRHO_PLUGIN_WANT_TIMEPOS
+            timePosition.isPlaying = block % 256 < 200;
+            timePosition.bbtSupported = false;
+            fPlugin.setTimePosition(timePosition);
+            if (timePosition.isPlaying)
+                timePosition.frame += frames;
+           #endif
+
+            fMidiOutputCount = 0;
+
+            const uint32_t violationCount = d_getRealtimeViolationCount();
+
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+           #if DISTRHO_PLUGIN_WANT_MIDI_INPUT
+            fPlugin.run(inputs, outputs, frames, midiEvents, midiEventCount);
+           #else
+            fPlugin.run(inputs, outputs, frames);
+           #endif
+            const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+            const uint64_t nanoseconds = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            totalNanoseconds += nanoseconds;
+            totalFrames += frames;
+            maxBlockNanosecondsPerFrame = std::max(maxBlockNanosecondsPerFrame, nanoseconds / frames);
+
+            // allocations and locks inside run, details have been reported by the checker already
+            if (d_getRealtimeViolationCount() != violationCount)
+                fail("realtime-safety violation during run", d_getRealtimeViolationCount() - violationCount, block);
+
+            // output checks
+            bool hasDenormals = false;
+
+            for (uint32_t c = 0; c < numOutputs; ++c)
+            {
+                for (uint32_t i = 0; i < frames; ++i)
+                {
+                    if (isNotFinite(outputs[c][i]))
+                    {
+                        fail("audio output is NaN or infinite", c, block);
+                        break;
+                    }
+
+                    hasDenormals = hasDenormals || isDenormal(outputs[c][i]);
+                }
+            }
+
+            for (uint32_t i = 0, count = fPlugin.getParameterCount(); i < count; ++i)
+            {
+                if (fPlugin.isParameterOutput(i) && isNotFinite(fPlugin.getParameterValue(i)))
+                    fail("output parameter is NaN or infinite", i, block);
+            }
+
+            if (hasDenormals)
+                ++denormalBlocks;
+        }
+
+        fPlugin.deactivate();
+
+        delete[] audioBuffer;
+
+        // processing time relative to the audio duration, 100% would be using all available time
+        const double audioNanoseconds = static_cast<double>(totalFrames) / sampleRate * 1000000000.0;
+
+        d_stdout("  buffer size %4u, sample rate %6.0f: %6.2f ns/frame avg, %6llu ns/frame worst block, %.3f%% DSP load",
+                 bufferSize, sampleRate,
+                 static_cast<double>(totalNanoseconds) / static_cast<double>(totalFrames),
+                 static_cast<unsigned long long>(maxBlockNanosecondsPerFrame),
+                 static_cast<double>(totalNanoseconds) / audioNanoseconds * 100.0);
+
+        if (denormalBlocks != 0)
+            d_stderr("  warning: %u block(s) had denormal output values", denormalBlocks);
+    }
+
+    // ----------------------------------------------------------------------------------------------------------------
+    // host callbacks
+
+    static bool writeMidiCallback(void* const ptr, const MidiEvent&)
+    {
+        PluginTestHost* const self = static_cast<PluginTestHost*>(ptr);
+
+        if (self->fMidiOutputCount >= kMaxMidiEvents)
+            return false;
+
+        ++self->fMidiOutputCount;
+        return true;
+    }
+
+    static bool requestParameterValueChangeCallback(void*, const uint32_t, const float)
+    {
+        return true;
+    }
+
+    DISTRHO_DECLARE_NON_COPYABLE(PluginTestHost)
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+    const uint32_t blocksPerConfig = argc > 1 ? static_cast<uint32_t>(std::max(1, std::atoi(argv[1]))) : 2000;
+    const uint32_t seed = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 1;
+
+    d_nextBufferSize = 512;
+    d_nextSampleRate = 44100.0;
+    d_nextCanRequestParameterValueChanges = true;
+
+    bool ok;
+
+    {
+        PluginTestHost host(blocksPerConfig, seed);
+        ok = host.run();
+    }
+
+    return ok ? 0 : 1;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
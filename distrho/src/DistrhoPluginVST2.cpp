@@ -1355,6 +1355,7 @@ const vst_effect* VSTPluginMain(const vst_host_callback audioMaster)
         d_nextBufferSize = 512;
         d_nextSampleRate = 44100.0;
         d_nextCanRequestParameterValueChanges = true;
+        d_nextPluginIsDummy = true;
 
         // Create dummy plugin to get data from
         sPlugin = new PluginExporter(nullptr, nullptr, nullptr);
@@ -1363,6 +1364,7 @@ const vst_effect* VSTPluginMain(const vst_host_callback audioMaster)
         d_nextBufferSize = 0;
         d_nextSampleRate = 0.0;
         d_nextCanRequestParameterValueChanges = false;
+        d_nextPluginIsDummy = false;
     }
 
     ExtendedAEffect* const effect = new ExtendedAEffect;
@@ -1370,6 +1370,7 @@ public:
 
         {
             int32_t i = 0;
+            uint64_t inputSilenceMask = 0;
 #if DISTRHO_PLUGIN_NUM_INPUTS > 0
             if (data->inputs != nullptr)
             {
@@ -1380,17 +1381,28 @@ public:
                         DISTRHO_SAFE_ASSERT_INT_BREAK(i < DISTRHO_PLUGIN_NUM_INPUTS, i);
                         if (! fEnabledInputs[i] && i < DISTRHO_PLUGIN_NUM_INPUTS)
                         {
+                            if (i < 64)
+                                inputSilenceMask |= 1ULL << i;
                             inputs[i++] = fDummyAudioBuffer;
                             continue;
                         }
 
+                        if (i < 64 && j < 64 && (data->inputs[b].silenceFlags & (1ULL << j)) != 0)
+                            inputSilenceMask |= 1ULL << i;
+
                         inputs[i++] = data->inputs[b].Steinberg_Vst_AudioBusBuffers_channelBuffers32[j];
                     }
                 }
             }
 #endif
             for (; i < std::max(1, DISTRHO_PLUGIN_NUM_INPUTS); ++i)
+            {
+                if (i < 64)
+                    inputSilenceMask |= 1ULL << i;
                 inputs[i] = fDummyAudioBuffer;
+            }
+
+            fPlugin.setInputSilenceMask(inputSilenceMask);
         }
 
         {
@@ -1525,6 +1537,25 @@ public:
         fHostEventOutputHandle = nullptr;
 #endif
 
+#if DISTRHO_PLUGIN_NUM_OUTPUTS > 0
+        // report silent outputs to the host
+        if (data->outputs != nullptr)
+        {
+            const uint64_t outputSilenceMask = fPlugin.getOutputSilenceMask();
+
+            for (int32_t b = 0, i = 0; b < data->numOutputs; ++b)
+            {
+                data->outputs[b].silenceFlags = 0;
+
+                for (int32_t j = 0; j < data->outputs[b].numChannels; ++j, ++i)
+                {
+                    if (i < 64 && j < 64 && (outputSilenceMask & (1ULL << i)) != 0)
+                        data->outputs[b].silenceFlags |= 1ULL << j;
+                }
+            }
+        }
+#endif
+
         // if there are any parameter changes after frame 0, set them here
         if (Steinberg_Vst_IParameterChanges* const inparamsptr = data->inputParameterChanges)
         {
@@ -3929,6 +3960,153 @@ Steinberg_tresult vst3factory_set_host_context(void* const self, Steinberg_FUnkn
     return Steinberg_kResultOk;
 }
 
+// --------------------------------------------------------------------------------------------------------------------
+// plugin specific uids setup, used by the module entry and moduleinfo generation
+
+static void setPluginUniqueIds()
+{
+    const uint32_t id = plugin_getUniqueId();
+    memcpy(&dpf_tuid_class[2], &id, 4);
+    memcpy(&dpf_tuid_component[2], &id, 4);
+    memcpy(&dpf_tuid_controller[2], &id, 4);
+    memcpy(&dpf_tuid_processor[2], &id, 4);
+    memcpy(&dpf_tuid_view[2], &id, 4);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// moduleinfo.json generation, see https://steinbergmedia.github.io/vst3_dev_portal/pages/Technical+Documentation/VST+Module+Architecture/ModuleInfo-JSON.html
+// This only uses static plugin information, hosts that read moduleinfo.json can skip loading the binary during scans.
+
+static String moduleInfoString(const char* const str)
+{
+    String escaped("\"");
+
+    for (const char* c = str; *c != '\0'; ++c)
+    {
+        char buf[8];
+
+        switch (*c)
+        {
+        case '"':
+            escaped += "\\\"";
+            break;
+        case '\\':
+            escaped += "\\\\";
+            break;
+        case '\n':
+            escaped += "\\n";
+            break;
+        case '\t':
+            escaped += "\\t";
+            break;
+        default:
+            if (static_cast<uint8_t>(*c) < 0x20)
+            {
+                std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<uint8_t>(*c));
+                escaped += buf;
+            }
+            else
+            {
+                buf[0] = *c;
+                buf[1] = '\0';
+                escaped += buf;
+            }
+            break;
+        }
+    }
+
+    escaped += "\"";
+    return escaped;
+}
+
+static String moduleInfoClassId(const dpf_tuid tuid)
+{
+    uint8_t bytes[16];
+    memcpy(bytes, tuid, sizeof(bytes));
+
+    char buf[40];
+   #ifdef DISTRHO_OS_WINDOWS
+    // COM compatible GUID layout, first 3 fields are stored as little-endian integers
+    std::snprintf(buf, sizeof(buf), "\"%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X\"",
+                  bytes[3], bytes[2], bytes[1], bytes[0], bytes[5], bytes[4], bytes[7], bytes[6],
+                  bytes[8], bytes[9], bytes[10], bytes[11], bytes[12], bytes[13], bytes[14], bytes[15]);
+   #else
+    std::snprintf(buf, sizeof(buf), "\"%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X\"",
+                  bytes[0], bytes[1], bytes[2], bytes[3], bytes[4], bytes[5], bytes[6], bytes[7],
+                  bytes[8], bytes[9], bytes[10], bytes[11], bytes[12], bytes[13], bytes[14], bytes[15]);
+   #endif
+    return String(buf);
+}
+
+DISTRHO_PLUGIN_EXPORT
+void vst3_generate_moduleinfo(const char* basename);
+
+void vst3_generate_moduleinfo(const char*)
+{
+    setPluginUniqueIds();
+
+    String subCategories("[");
+    {
+        const String categories(getPluginCategories());
+        const char* start = categories.buffer();
+
+        while (*start != '\0')
+        {
+            const char* const end = std::strchr(start, '|');
+            const String category(end != nullptr ? String(start).truncate(end - start) : String(start));
+
+            if (subCategories.length() != 1)
+                subCategories += ", ";
+            subCategories += moduleInfoString(category);
+
+            if (end == nullptr)
+                break;
+            start = end + 1;
+        }
+    }
+    subCategories += "]";
+
+    String json;
+    json += "{\n";
+    json += "  \"Name\": " + moduleInfoString(plugin_getName()) + ",\n";
+    json += "  \"Version\": " + moduleInfoString(getPluginVersion()) + ",\n";
+    json += "  \"Factory Info\": {\n";
+    json += "    \"Vendor\": " + moduleInfoString(plugin_getMaker()) + ",\n";
+    json += "    \"URL\": " + moduleInfoString(plugin_getHomePage()) + ",\n";
+    json += "    \"E-Mail\": \"\",\n";
+    json += "    \"Flags\": {\n";
+    json += "      \"Unicode\": true,\n";
+    json += "      \"Classes Discardable\": false,\n";
+    json += "      \"Component Non Discardable\": false\n";
+    json += "    }\n";
+    json += "  },\n";
+    json += "  \"Compatibility\": [],\n";
+    json += "  \"Classes\": [\n";
+    // must match what the factory reports, see vst3factory_get_class_info_2
+    json += "    {\n";
+    json += "      \"CID\": " + moduleInfoClassId(dpf_tuid_class) + ",\n";
+    json += "      \"Category\": \"Audio Module Class\",\n";
+    json += "      \"Name\": " + moduleInfoString(plugin_getName()) + ",\n";
+    json += "      \"Vendor\": " + moduleInfoString(plugin_getMaker()) + ",\n";
+    json += "      \"Version\": " + moduleInfoString(getPluginVersion()) + ",\n";
+    json += "      \"SDKVersion\": " + moduleInfoString(Steinberg_Vst_SDKVersionString) + ",\n";
+    json += "      \"Sub Categories\": " + subCategories + ",\n";
+    json += "      \"Class Flags\": " + String(static_cast<int>(Steinberg_Vst_ComponentFlags_kSimpleModeSupported)) + ",\n";
+    json += "      \"Cardinality\": " + String(static_cast<int>(Steinberg_PClassInfo_ClassCardinality_kManyInstances)) + ",\n";
+    json += "      \"Snapshots\": []\n";
+    json += "    }\n";
+    json += "  ]\n";
+    json += "}\n";
+
+    d_stdout("Writing moduleinfo.json...");
+
+    FILE* const file = std::fopen("moduleinfo.json", "w");
+    DISTRHO_SAFE_ASSERT_RETURN(file != nullptr,);
+
+    std::fwrite(json.buffer(), 1, json.length(), file);
+    std::fclose(file);
+}
+
 // --------------------------------------------------------------------------------------------------------------------
 // VST3 entry point
 
@@ -3990,12 +4168,7 @@ bool ENTRYFNNAME(ENTRYFNNAMEARGS)
     // d_nextSampleRate                      = 0.0;
     d_nextCanRequestParameterValueChanges = false;
 
-    uint32_t id = plugin_getUniqueId();
-    memcpy(&dpf_tuid_class[2], &id, 4);
-    memcpy(&dpf_tuid_component[2], &id, 4);
-    memcpy(&dpf_tuid_controller[2], &id, 4);
-    memcpy(&dpf_tuid_processor[2], &id, 4);
-    memcpy(&dpf_tuid_view[2], &id, 4);
+    setPluginUniqueIds();
 
     return true;
 }
@@ -4005,6 +4178,9 @@ bool EXITFNNAME(void);
 
 bool EXITFNNAME(void) {
     d_debug("Bundle exit");
+   #if DISTRHO_PLUGIN_WANT_INSTANCE_POOL
+    PluginExporter::clearInstancePool();
+   #endif
     return true;
 }
 
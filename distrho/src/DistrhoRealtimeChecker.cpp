@@ -0,0 +1,233 @@
+/*
+ * DISTRHO Plugin Framework (DPF)
+ * Copyright (C) 2012-2023 Filipe Coelho <falktx@falktx.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any purpose with
+ * or without fee is hereby granted, provided that the above copyright notice and this
+ * permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+ * TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+ * NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+ * IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Realtime-safety checker, enabled with DPF_REALTIME_CHECKS.
+ *
+ * PluginExporter::run() marks the calling thread as being in realtime context while the plugin processes audio.
+ * The allocator and mutex functions below are interposed for the whole plugin binary,
+ * reporting (with a backtrace) any allocation, deallocation or blocking lock done while that mark is set.
+ *
+ * The plugin formats export only their entry point (see utils/symbols/), every other symbol is local to the binary.
+ * So the hooks only see calls made from the plugin binary itself, which covers the plugin code and inlined templates,
+ * but not calls made from within other shared libraries (the C++ runtime, libc itself or anything else linked in).
+ * An allocation done inside a non-inlined libstdc++ function called from run() goes unreported, for example.
+ * Interposing needs glibc, on other systems only the realtime context tracking is done.
+ */
+
+#include "DistrhoPluginInternal.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(__GLIBC__) && ! defined(DISTRHO_OS_WASM)
+# include <dlfcn.h>
+# include <execinfo.h>
+# include <pthread.h>
+# include <unistd.h>
+# define DISTRHO_REALTIME_CHECKER_HOOKS 1
+extern "C" {
+// glibc exports the real allocator under these names, which avoids dlsym (which may allocate itself)
+void* __libc_malloc(size_t);
+void* __libc_calloc(size_t, size_t);
+void* __libc_realloc(void*, size_t);
+void  __libc_free(void*);
+}
+#else
+# define DISTRHO_REALTIME_CHECKER_HOOKS 0
+#endif
+
+// --------------------------------------------------------------------------------------------------------------------
+
+static thread_local bool     sIsRealtimeContext = false;
+static thread_local uint32_t sContextViolationCount = 0;
+static std::atomic<uint32_t> sTotalViolationCount(0);
+
+void d_enterRealtimeContext() noexcept
+{
+    sContextViolationCount = 0;
+    sIsRealtimeContext = true;
+}
+
+void d_leaveRealtimeContext() noexcept
+{
+    sIsRealtimeContext = false;
+
+    // only the first violation of each run() call gets a full report, the rest are summarized here
+    if (sContextViolationCount > 1)
+        d_stderr2("DPF realtime violation: %u more inside the same run() call", sContextViolationCount - 1);
+}
+
+uint32_t d_getRealtimeViolationCount() noexcept
+{
+    return sTotalViolationCount.load(std::memory_order_relaxed);
+}
+
+#if DISTRHO_REALTIME_CHECKER_HOOKS
+static void reportRealtimeViolation(const char* const function) noexcept
+{
+    sTotalViolationCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (sContextViolationCount++ != 0)
+        return;
+
+    // the report itself is not realtime safe, avoid reporting on it
+    sIsRealtimeContext = false;
+
+    d_stderr2("DPF realtime violation: %s called inside run(), backtrace follows:", function);
+
+    void* frames[32];
+    const int numFrames = backtrace(frames, ARRAY_SIZE(frames));
+
+    // skip this function, symbols for non-exported functions can be resolved with addr2line
+    backtrace_symbols_fd(frames + 1, numFrames - 1, STDERR_FILENO);
+
+    sIsRealtimeContext = true;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// C allocator and pthread hooks
+
+typedef int (*pthread_mutex_lock_func)(pthread_mutex_t*);
+
+// resolved once while the binary is being loaded, dlsym must never be called from inside run()
+static pthread_mutex_lock_func sRealMutexLock = nullptr;
+
+__attribute__((constructor(101)))
+static void d_initRealtimeChecker()
+{
+    sRealMutexLock = (pthread_mutex_lock_func)dlsym(RTLD_NEXT, "pthread_mutex_lock");
+}
+
+extern "C" {
+
+void* malloc(const size_t size)
+{
+    if (sIsRealtimeContext)
+        reportRealtimeViolation("malloc");
+
+    return __libc_malloc(size);
+}
+
+void* calloc(const size_t count, const size_t size)
+{
+    if (sIsRealtimeContext)
+        reportRealtimeViolation("calloc");
+
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* const ptr, const size_t size)
+{
+    if (sIsRealtimeContext)
+        reportRealtimeViolation("realloc");
+
+    return __libc_realloc(ptr, size);
+}
+
+void free(void* const ptr)
+{
+    if (ptr != nullptr && sIsRealtimeContext)
+        reportRealtimeViolation("free");
+
+    __libc_free(ptr);
+}
+
+// pthread_mutex_trylock is fine to use in realtime context, so only the blocking variant is checked
+int pthread_mutex_lock(pthread_mutex_t* const mutex)
+{
+    // only possible for static constructors running before ours, which is still during load
+    if (sRealMutexLock == nullptr)
+        d_initRealtimeChecker();
+
+    if (sIsRealtimeContext)
+        reportRealtimeViolation("pthread_mutex_lock");
+
+    return sRealMutexLock(mutex);
+}
+
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// C++ allocator hooks, the default ones live in the C++ runtime library and would bypass the C hooks above
+
+void* operator new(const std::size_t size)
+{
+    if (sIsRealtimeContext)
+        reportRealtimeViolation("operator new");
+
+    if (void* const ptr = __libc_malloc(size != 0 ? size : 1))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](const std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(const std::size_t size, const std::nothrow_t&) noexcept
+{
+    if (sIsRealtimeContext)
+        reportRealtimeViolation("operator new");
+
+    return __libc_malloc(size != 0 ? size : 1);
+}
+
+void* operator new[](const std::size_t size, const std::nothrow_t& nothrow) noexcept
+{
+    return operator new(size, nothrow);
+}
+
+void operator delete(void* const ptr) noexcept
+{
+    if (ptr != nullptr && sIsRealtimeContext)
+        reportRealtimeViolation("operator delete");
+
+    __libc_free(ptr);
+}
+
+void operator delete[](void* const ptr) noexcept
+{
+    operator delete(ptr);
+}
+
+void operator delete(void* const ptr, const std::nothrow_t&) noexcept
+{
+    operator delete(ptr);
+}
+
+void operator delete[](void* const ptr, const std::nothrow_t&) noexcept
+{
+    operator delete(ptr);
+}
+
+# ifdef __cpp_sized_deallocation
+void operator delete(void* const ptr, std::size_t) noexcept
+{
+    operator delete(ptr);
+}
+
+void operator delete[](void* const ptr, std::size_t) noexcept
+{
+    operator delete(ptr);
+}
+# endif
+#endif // DISTRHO_REALTIME_CHECKER_HOOKS
+
+// --------------------------------------------------------------------------------------------------------------------
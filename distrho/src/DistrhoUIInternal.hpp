@@ -19,6 +19,10 @@
 
 #include "DistrhoUIPrivateData.hpp"
 
+#if DISTRHO_UI_FRAME_RATE != 0
+# include <chrono>
+#endif
+
 
 // -----------------------------------------------------------------------
 // Static data, see DistrhoUI.cpp
@@ -40,6 +44,16 @@ class UIExporter
     UI* ui;
     UI::PrivateData* uiData;
 
+   #if DISTRHO_UI_FRAME_RATE != 0
+    // -------------------------------------------------------------------
+    // Parameter changes waiting for the next frame, one slot per parameter so only its last value is kept
+
+    float* const pendingParameterValues;
+    bool* const pendingParameterChanges;
+    bool hasPendingParameterChanges;
+    std::chrono::steady_clock::time_point lastParameterChangesFlush;
+   #endif
+
     // -------------------------------------------------------------------
 
 public:
@@ -59,7 +73,17 @@ public:
                const char* const appClassName = nullptr)
         : ui(nullptr),
           uiData(new UI::PrivateData(appClassName))
+       #if DISTRHO_UI_FRAME_RATE != 0
+        , pendingParameterValues(new float[DISTRHO_PLUGIN_NUM_PARAMS]),
+          pendingParameterChanges(new bool[DISTRHO_PLUGIN_NUM_PARAMS]),
+          hasPendingParameterChanges(false),
+          lastParameterChangesFlush()
+       #endif
     {
+       #if DISTRHO_UI_FRAME_RATE != 0
+        std::memset(pendingParameterChanges, 0, sizeof(bool) * DISTRHO_PLUGIN_NUM_PARAMS);
+       #endif
+
         uiData->sampleRate = sampleRate;
         uiData->bundlePath = bundlePath != nullptr ? strdup(bundlePath) : nullptr;
         uiData->dspPtr = dspPtr;
@@ -113,6 +137,11 @@ public:
 #endif
         delete ui;
         delete uiData;
+
+       #if DISTRHO_UI_FRAME_RATE != 0
+        delete[] pendingParameterValues;
+        delete[] pendingParameterChanges;
+       #endif
     }
 
     // -------------------------------------------------------------------
@@ -188,8 +217,44 @@ public:
     {
         DISTRHO_SAFE_ASSERT_RETURN(ui != nullptr,);
 
+       #if DISTRHO_UI_FRAME_RATE != 0
+        DISTRHO_SAFE_ASSERT_UINT2_RETURN(index < DISTRHO_PLUGIN_NUM_PARAMS, index, DISTRHO_PLUGIN_NUM_PARAMS,);
+
+        pendingParameterValues[index] = value;
+        pendingParameterChanges[index] = true;
+        hasPendingParameterChanges = true;
+       #else
         ui->parameterChanged(index, value);
+       #endif
+    }
+
+   #if DISTRHO_UI_FRAME_RATE != 0
+    // deliver pending parameter changes, at most once per frame and only while the UI is visible
+    void flushParameterChanges()
+    {
+        if (! hasPendingParameterChanges || ! uiData->window->isVisible())
+            return;
+
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+        if (now - lastParameterChangesFlush < std::chrono::microseconds(1000000 / DISTRHO_UI_FRAME_RATE))
+            return;
+
+        lastParameterChangesFlush = now;
+        hasPendingParameterChanges = false;
+
+        for (uint32_t i = 0; i < DISTRHO_PLUGIN_NUM_PARAMS; ++i)
+        {
+            if (pendingParameterChanges[i])
+            {
+                pendingParameterChanges[i] = false;
+                ui->parameterChanged(i, pendingParameterValues[i]);
+            }
+        }
+
+        ui->parameterChangesBatch();
     }
+   #endif
 
     // -------------------------------------------------------------------
 
@@ -208,6 +273,9 @@ public:
     {
         DISTRHO_SAFE_ASSERT_RETURN(ui != nullptr, );
 
+       #if DISTRHO_UI_FRAME_RATE != 0
+        flushParameterChanges();
+       #endif
         ui->uiIdle();
     }
 
@@ -222,6 +290,9 @@ public:
     {
         DISTRHO_SAFE_ASSERT_RETURN(ui != nullptr, false);
 
+       #if DISTRHO_UI_FRAME_RATE != 0
+        flushParameterChanges();
+       #endif
         uiData->app.idle();
         ui->uiIdle();
         return ! uiData->app.isQuitting();
@@ -252,6 +323,9 @@ public:
     {
         DISTRHO_SAFE_ASSERT_RETURN(ui != nullptr,);
 
+       #if DISTRHO_UI_FRAME_RATE != 0
+        flushParameterChanges();
+       #endif
         uiData->app.triggerIdleCallbacks();
         ui->uiIdle();
     }
@@ -98,6 +98,8 @@ const char* getPluginFormatName() noexcept
     return "VST3";
 #elif defined(DISTRHO_PLUGIN_TARGET_CLAP)
     return "CLAP";
+#elif defined(DISTRHO_PLUGIN_TARGET_TEST)
+    return "Test";
 #elif defined(DISTRHO_PLUGIN_TARGET_STATIC) && defined(DISTRHO_PLUGIN_TARGET_STATIC_NAME)
     return DISTRHO_PLUGIN_TARGET_STATIC_NAME;
 #else
@@ -30,6 +30,7 @@
 #define DISTRHO_PLUGIN_NUM_PARAMS   1
 
 #define DISTRHO_PLUGIN_WANT_DIRECT_ACCESS 1
+#define DISTRHO_PLUGIN_WANT_INSTANCE_POOL 1
 #define DPF_VST3_USES_SEPARATE_CONTROLLER 0
 
 #endif // DISTRHO_PLUGIN_INFO_H_INCLUDED
@@ -30,6 +30,7 @@
 #define DISTRHO_UI_USER_RESIZABLE  1
 #define DISTRHO_UI_USE_NANOVG      1
 #define DISTRHO_PLUGIN_NUM_PARAMS  3
+#define DISTRHO_PLUGIN_WANT_PARAMETER_DESCRIPTORS 1
 
 #define METER_COLOR_GREEN 0
 #define METER_COLOR_BLUE  1
@@ -241,6 +241,12 @@ void plugin_run(void* ptr, const float** inputs, float** outputs, uint32_t frame
 
     if (outputs[1] != inputs[1])
         std::memcpy(outputs[1], inputs[1], sizeof(float)*frames);
+
+    /**
+        Since the audio is untouched, silent inputs result in silent outputs.
+        Letting the host know allows it to skip processing further down the chain.
+    */
+    plugin_setOutputSilenceMask(ptr, plugin_getInputSilenceMask(ptr));
 }
 
 void plugin_bufferSizeChanged(void* ptr, uint32_t newBufferSize) {}
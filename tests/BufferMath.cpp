@@ -0,0 +1,208 @@
+/*
+ * DISTRHO Plugin Framework (DPF)
+ * Copyright (C) 2012-2023 Filipe Coelho <falktx@falktx.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any purpose with
+ * or without fee is hereby granted, provided that the above copyright notice and this
+ * permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+ * TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+ * NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+ * IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "tests.hpp"
+
+#include "extra/BufferMath.hpp"
+
+// --------------------------------------------------------------------------------------------------------------------
+
+// big enough for all vector widths plus leftovers, odd offset to test unaligned access
+static const uint32_t kMaxFrames = 67;
+static const uint32_t kOffset = 1;
+
+static float sInputA[kMaxFrames * 2 + kOffset];
+static float sInputB[kMaxFrames * 2 + kOffset];
+static int16_t sInput16[kMaxFrames + kOffset];
+static int32_t sInput32[kMaxFrames + kOffset];
+
+static void fillInputs()
+{
+    uint32_t seed = 0x12345678;
+
+    for (uint32_t i=0; i<kMaxFrames * 2 + kOffset; ++i)
+    {
+        // simple LCG, values in -1.25..1.25 range to also test clipping
+        seed = seed * 1664525u + 1013904223u;
+        sInputA[i] = static_cast<float>(static_cast<int32_t>(seed)) / 2147483648.f * 1.25f;
+        seed = seed * 1664525u + 1013904223u;
+        sInputB[i] = static_cast<float>(static_cast<int32_t>(seed)) / 2147483648.f * 1.25f;
+    }
+
+    for (uint32_t i=0; i<kMaxFrames + kOffset; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        sInput32[i] = static_cast<int32_t>(seed);
+        sInput16[i] = static_cast<int16_t>(seed >> 16);
+    }
+
+    // extremes
+    sInputA[kOffset] = 1.f;
+    sInputA[kOffset + 1] = -1.f;
+    sInputA[kOffset + 2] = 0.f;
+    sInput16[kOffset] = -32768;
+    sInput32[kOffset] = -2147483647 - 1;
+}
+
+template <typename T>
+static bool isBitExact(const T* const a, const T* const b, const uint32_t count)
+{
+    return std::memcmp(a, b, sizeof(T) * count) == 0;
+}
+
+static bool isBitExact(const float a, const float b)
+{
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+template <class Impl>
+static int testImplementation(const char* const name)
+{
+    float ref[kMaxFrames * 2];
+    float res[kMaxFrames * 2];
+    float refR[kMaxFrames];
+    float resR[kMaxFrames];
+    int16_t ref16[kMaxFrames];
+    int16_t res16[kMaxFrames];
+    int32_t ref32[kMaxFrames];
+    int32_t res32[kMaxFrames];
+
+    const float* const a = sInputA + kOffset;
+    const float* const b = sInputB + kOffset;
+
+    for (uint32_t frames=0; frames<=kMaxFrames; ++frames)
+    {
+        std::memcpy(ref, a, sizeof(float) * frames);
+        std::memcpy(res, a, sizeof(float) * frames);
+        BufferMathScalar::add(ref, b, frames);
+        Impl::add(res, b, frames);
+        DISTRHO_ASSERT_EQUAL(isBitExact(ref, res, frames), true, name);
+
+        std::memcpy(ref, a, sizeof(float) * frames);
+        std::memcpy(res, a, sizeof(float) * frames);
+        BufferMathScalar::multiplyAdd(ref, b, 0.3f, frames);
+        Impl::multiplyAdd(res, b, 0.3f, frames);
+        DISTRHO_ASSERT_EQUAL(isBitExact(ref, res, frames), true, name);
+
+        std::memcpy(ref, a, sizeof(float) * frames);
+        std::memcpy(res, a, sizeof(float) * frames);
+        BufferMathScalar::applyGain(ref, 0.7f, frames);
+        Impl::applyGain(res, 0.7f, frames);
+        DISTRHO_ASSERT_EQUAL(isBitExact(ref, res, frames), true, name);
+
+        std::memcpy(ref, a, sizeof(float) * frames);
+        std::memcpy(res, a, sizeof(float) * frames);
+        BufferMathScalar::applyGainRamp(ref, 0.1f, 0.013f, frames);
+        Impl::applyGainRamp(res, 0.1f, 0.013f, frames);
+        DISTRHO_ASSERT_EQUAL(isBitExact(ref, res, frames), true, name);
+
+        DISTRHO_ASSERT_EQUAL(isBitExact(BufferMathScalar::peak(a, frames), Impl::peak(a, frames)), true, name);
+        DISTRHO_ASSERT_EQUAL(isBitExact(BufferMathScalar::sumOfSquares(a, frames),
+                                        Impl::sumOfSquares(a, frames)), true, name);
+
+        BufferMathScalar::interleave(ref, a, b, frames);
+        Impl::interleave(res, a, b, frames);
+        DISTRHO_ASSERT_EQUAL(isBitExact(ref, res, frames * 2), true, name);
+
+        BufferMathScalar::deinterleave(ref, refR, a, frames);
+        Impl::deinterleave(res, resR, a, frames);
+        DISTRHO_ASSERT_EQUAL(isBitExact(ref, res, frames), true, name);
+        DISTRHO_ASSERT_EQUAL(isBitExact(refR, resR, frames), true, name);
+
+        BufferMathScalar::toInt16(ref16, a, frames);
+        Impl::toInt16(res16, a, frames);
+        DISTRHO_ASSERT_EQUAL(isBitExact(ref16, res16, frames), true, name);
+
+        BufferMathScalar::fromInt16(ref, sInput16 + kOffset, frames);
+        Impl::fromInt16(res, sInput16 + kOffset, frames);
+        DISTRHO_ASSERT_EQUAL(isBitExact(ref, res, frames), true, name);
+
+        BufferMathScalar::toInt32(ref32, a, frames);
+        Impl::toInt32(res32, a, frames);
+        DISTRHO_ASSERT_EQUAL(isBitExact(ref32, res32, frames), true, name);
+
+        BufferMathScalar::fromInt32(ref, sInput32 + kOffset, frames);
+        Impl::fromInt32(res, sInput32 + kOffset, frames);
+        DISTRHO_ASSERT_EQUAL(isBitExact(ref, res, frames), true, name);
+    }
+
+    return 0;
+}
+
+static int testScalarValues()
+{
+    const float* const a = sInputA + kOffset;
+
+    // the first values are 1, -1 and 0
+    DISTRHO_ASSERT_SAFE_EQUAL(BufferMathScalar::peak(a, 3), 1.f, "peak");
+    DISTRHO_ASSERT_SAFE_EQUAL(d_bufferRMS(a, 3), std::sqrt(2.f / 3.f), "rms");
+
+    int16_t i16[3];
+    BufferMathScalar::toInt16(i16, a, 3);
+    DISTRHO_ASSERT_EQUAL(i16[0], 32767, "int16 positive clip");
+    DISTRHO_ASSERT_EQUAL(i16[1], -32768, "int16 negative full scale");
+    DISTRHO_ASSERT_EQUAL(i16[2], 0, "int16 zero");
+
+    int32_t i32[3];
+    BufferMathScalar::toInt32(i32, a, 3);
+    DISTRHO_ASSERT_EQUAL(i32[0], 2147483520, "int32 positive clip");
+    DISTRHO_ASSERT_EQUAL(i32[1], -2147483647 - 1, "int32 negative full scale");
+    DISTRHO_ASSERT_EQUAL(i32[2], 0, "int32 zero");
+
+    // gain ramp must end one step short of the target gain
+    float ramp[4] = { 1.f, 1.f, 1.f, 1.f };
+    d_bufferApplyGainRamp(ramp, 0.f, 1.f, 4);
+    DISTRHO_ASSERT_SAFE_EQUAL(ramp[0], 0.f, "ramp start");
+    DISTRHO_ASSERT_SAFE_EQUAL(ramp[3], 0.75f, "ramp end");
+
+    return 0;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+int main()
+{
+    fillInputs();
+
+    if (testScalarValues() != 0)
+        return 1;
+
+   #ifdef DISTRHO_BUFFER_MATH_SSE2
+    if (testImplementation<BufferMathSSE2>("SSE2 matches scalar") != 0)
+        return 1;
+   #endif
+
+   #ifdef DISTRHO_BUFFER_MATH_AVX2
+    if (BufferMathAVX2::isSupported())
+    {
+        if (testImplementation<BufferMathAVX2>("AVX2 matches scalar") != 0)
+            return 1;
+    }
+    else
+    {
+        d_stdout("AVX2 not supported by this CPU, skipped");
+    }
+   #endif
+
+   #ifdef DISTRHO_BUFFER_MATH_NEON
+    if (testImplementation<BufferMathNEON>("NEON matches scalar") != 0)
+        return 1;
+   #endif
+
+    return 0;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
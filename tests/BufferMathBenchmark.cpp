@@ -0,0 +1,131 @@
+/*
+ * DISTRHO Plugin Framework (DPF)
+ * Copyright (C) 2012-2023 Filipe Coelho <falktx@falktx.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any purpose with
+ * or without fee is hereby granted, provided that the above copyright notice and this
+ * permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+ * TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+ * NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+ * IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "tests.hpp"
+
+#include "extra/BufferMath.hpp"
+
+#include <chrono>
+
+// --------------------------------------------------------------------------------------------------------------------
+
+static const uint32_t kFrames = 512;
+static const uint32_t kIterations = 200000;
+
+static float sBufferA[kFrames * 2];
+static float sBufferB[kFrames];
+static int16_t sBuffer16[kFrames];
+
+// prevents the compiler from optimizing away results
+static volatile float sSink;
+
+template <class Impl>
+static void benchmark(const char* const name)
+{
+    typedef std::chrono::steady_clock clock;
+
+    // NOTE the first sample is changed on each iteration, so calls are not hoisted out of the loops
+
+    const clock::time_point t0 = clock::now();
+    for (uint32_t i=0; i<kIterations; ++i)
+    {
+        sBufferB[0] = static_cast<float>(i & 1);
+        Impl::multiplyAdd(sBufferA, sBufferB, 0.5f, kFrames);
+    }
+
+    const clock::time_point t1 = clock::now();
+    for (uint32_t i=0; i<kIterations; ++i)
+    {
+        sBufferA[0] = static_cast<float>(i & 1);
+        Impl::applyGainRamp(sBufferA, 1.f, 0.f, kFrames);
+    }
+
+    const clock::time_point t2 = clock::now();
+    float peak = 0.f;
+    for (uint32_t i=0; i<kIterations; ++i)
+    {
+        sBufferA[0] = static_cast<float>(i & 1);
+        peak += Impl::peak(sBufferA, kFrames);
+    }
+    sSink = peak;
+
+    const clock::time_point t3 = clock::now();
+    float sum = 0.f;
+    for (uint32_t i=0; i<kIterations; ++i)
+    {
+        sBufferA[0] = static_cast<float>(i & 1);
+        sum += Impl::sumOfSquares(sBufferA, kFrames);
+    }
+    sSink = sum;
+
+    const clock::time_point t4 = clock::now();
+    for (uint32_t i=0; i<kIterations; ++i)
+    {
+        sBufferB[0] = static_cast<float>(i & 1);
+        Impl::interleave(sBufferA, sBufferB, sBufferB, kFrames);
+    }
+
+    const clock::time_point t5 = clock::now();
+    for (uint32_t i=0; i<kIterations; ++i)
+    {
+        sBufferB[0] = static_cast<float>(i & 1);
+        Impl::toInt16(sBuffer16, sBufferB, kFrames);
+    }
+
+    const clock::time_point t6 = clock::now();
+
+    typedef std::chrono::duration<double, std::nano> ns;
+    const double scale = 1.0 / kIterations;
+
+    d_stdout("%-6s multiplyAdd %8.1f ns | gainRamp %8.1f ns | peak %8.1f ns | sumOfSquares %8.1f ns | "
+             "interleave %8.1f ns | toInt16 %8.1f ns",
+             name,
+             ns(t1 - t0).count() * scale,
+             ns(t2 - t1).count() * scale,
+             ns(t3 - t2).count() * scale,
+             ns(t4 - t3).count() * scale,
+             ns(t5 - t4).count() * scale,
+             ns(t6 - t5).count() * scale);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+int main()
+{
+    for (uint32_t i=0; i<kFrames; ++i)
+        sBufferB[i] = std::sin(static_cast<float>(i) * 0.01f) * 0.5f;
+
+    d_stdout("BufferMath, %u frames per call, average time per call:", kFrames);
+
+    benchmark<BufferMathScalar>("scalar");
+
+   #ifdef DISTRHO_BUFFER_MATH_SSE2
+    benchmark<BufferMathSSE2>("SSE2");
+   #endif
+
+   #ifdef DISTRHO_BUFFER_MATH_AVX2
+    if (BufferMathAVX2::isSupported())
+        benchmark<BufferMathAVX2>("AVX2");
+   #endif
+
+   #ifdef DISTRHO_BUFFER_MATH_NEON
+    benchmark<BufferMathNEON>("NEON");
+   #endif
+
+    return 0;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,85 @@
+/*
+ * DISTRHO Plugin Framework (DPF)
+ * Copyright (C) 2012-2023 Filipe Coelho <falktx@falktx.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any purpose with
+ * or without fee is hereby granted, provided that the above copyright notice and this
+ * permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+ * TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+ * NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+ * IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "tests.hpp"
+
+#include "extra/FrameStream.hpp"
+
+// --------------------------------------------------------------------------------------------------------------------
+
+int main()
+{
+    FrameStream stream;
+    float block[10];
+    float frames[3 * 4];
+
+    DISTRHO_ASSERT_EQUAL(stream.init(4, 3), true, "init");
+    DISTRHO_ASSERT_EQUAL(stream.getNumAvailableFrames(), 0, "empty after init");
+    DISTRHO_ASSERT_EQUAL(stream.readLatestFrame(frames), false, "nothing to read after init");
+
+    for (uint32_t i=0; i<10; ++i)
+        block[i] = static_cast<float>(i);
+
+    // 10 values make 2 full frames, the remaining 2 values are not visible yet
+    stream.write(block, 10);
+    DISTRHO_ASSERT_EQUAL(stream.getNumAvailableFrames(), 2, "only complete frames are visible");
+
+    // completing the 3rd frame with 2 more values
+    stream.write(block, 2);
+    DISTRHO_ASSERT_EQUAL(stream.getNumAvailableFrames(), 3, "frame completed across writes");
+
+    // reading fewer frames than available skips the oldest ones
+    DISTRHO_ASSERT_EQUAL(stream.readFrames(frames, 2), 2, "read 2 frames");
+    DISTRHO_ASSERT_SAFE_EQUAL(frames[0], 4.f, "first read frame is the 2nd written");
+    DISTRHO_ASSERT_SAFE_EQUAL(frames[4], 8.f, "second read frame is the 3rd written");
+    DISTRHO_ASSERT_SAFE_EQUAL(frames[6], 0.f, "second read frame spans 2 writes");
+    DISTRHO_ASSERT_EQUAL(stream.getNumAvailableFrames(), 0, "stream drained");
+
+    // oldest frames are overwritten when the stream is full, latest frame wins
+    for (uint32_t i=0; i<10; ++i)
+    {
+        block[0] = static_cast<float>(i);
+        stream.writeFrame(block);
+    }
+    DISTRHO_ASSERT_EQUAL(stream.getNumAvailableFrames(), 3, "full stream keeps the queued amount");
+    DISTRHO_ASSERT_EQUAL(stream.readLatestFrame(frames), true, "read latest frame");
+    DISTRHO_ASSERT_SAFE_EQUAL(frames[0], 9.f, "latest frame is the newest written");
+    DISTRHO_ASSERT_EQUAL(stream.getNumAvailableFrames(), 0, "stream drained by latest frame read");
+
+    // reading several frames from a full stream gets the newest ones, oldest first
+    for (uint32_t i=0; i<10; ++i)
+    {
+        block[0] = static_cast<float>(i);
+        stream.writeFrame(block);
+    }
+    DISTRHO_ASSERT_EQUAL(stream.readFrames(frames, 3), 3, "read 3 frames from full stream");
+    DISTRHO_ASSERT_SAFE_EQUAL(frames[0], 7.f, "oldest kept frame");
+    DISTRHO_ASSERT_SAFE_EQUAL(frames[4], 8.f, "middle kept frame");
+    DISTRHO_ASSERT_SAFE_EQUAL(frames[8], 9.f, "newest frame");
+
+    // decimation keeps 1 of every N frames
+    stream.setDecimation(3);
+    for (uint32_t i=0; i<6; ++i)
+    {
+        block[0] = static_cast<float>(i);
+        stream.writeFrame(block);
+    }
+    DISTRHO_ASSERT_EQUAL(stream.readFrames(frames, 3), 2, "decimated frames");
+
+    return 0;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
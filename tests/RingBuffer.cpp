@@ -0,0 +1,104 @@
+/*
+ * DISTRHO Plugin Framework (DPF)
+ * Copyright (C) 2012-2023 Filipe Coelho <falktx@falktx.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any purpose with
+ * or without fee is hereby granted, provided that the above copyright notice and this
+ * permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+ * TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+ * NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+ * IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "tests.hpp"
+
+#include "extra/RingBuffer.hpp"
+
+// --------------------------------------------------------------------------------------------------------------------
+
+template <class RingBuffer>
+static int testRingBuffer(RingBuffer& rb)
+{
+    // regular write and read, with peek in between
+    DISTRHO_ASSERT_EQUAL(rb.isDataAvailableForReading(), false, "empty");
+    DISTRHO_ASSERT_EQUAL(rb.writeUInt(0x1234), true, "write");
+    DISTRHO_ASSERT_EQUAL(rb.isDataAvailableForReading(), false, "nothing available before commit");
+    DISTRHO_ASSERT_EQUAL(rb.commitWrite(), true, "commit");
+
+    uint32_t value = 0;
+    DISTRHO_ASSERT_EQUAL(rb.peekCustomData(&value, sizeof(value)), true, "peek");
+    DISTRHO_ASSERT_EQUAL(value, 0x1234, "peek value");
+    DISTRHO_ASSERT_EQUAL(rb.getReadableDataSize(), sizeof(value), "peek does not consume");
+    DISTRHO_ASSERT_EQUAL(rb.readUInt(), 0x1234, "read value");
+    DISTRHO_ASSERT_EQUAL(rb.isDataAvailableForReading(), false, "empty after read");
+
+    // zero-copy write up to the end of the buffer, which is size - 4 bytes from here
+    const uint32_t size = rb.getSize();
+    uint8_t* wdata;
+    DISTRHO_ASSERT_EQUAL(rb.acquireWrite(wdata), size - 4, "contiguous write region up to buffer end");
+
+    for (uint32_t i=0; i<size - 4; ++i)
+        wdata[i] = static_cast<uint8_t>(i);
+
+    rb.releaseWrite(size - 4);
+
+    // space left before the tail, minus the byte always kept free
+    DISTRHO_ASSERT_EQUAL(rb.acquireWrite(wdata), 3, "contiguous write region after wrap");
+    wdata[0] = 0xaa;
+    wdata[1] = 0xbb;
+    rb.releaseWrite(2);
+
+    DISTRHO_ASSERT_EQUAL(rb.isDataAvailableForReading(), false, "zero-copy writes need a commit");
+    DISTRHO_ASSERT_EQUAL(rb.commitWrite(), true, "commit zero-copy writes");
+    DISTRHO_ASSERT_EQUAL(rb.getReadableDataSize(), size - 2, "readable after zero-copy writes");
+
+    // zero-copy read, in 2 regions because of the wrap
+    const uint8_t* rdata;
+    DISTRHO_ASSERT_EQUAL(rb.acquireRead(rdata), size - 4, "contiguous read region up to buffer end");
+
+    for (uint32_t i=0; i<size - 4; ++i)
+    {
+        DISTRHO_ASSERT_EQUAL(rdata[i], static_cast<uint8_t>(i), "read data matches");
+    }
+
+    rb.releaseRead(size - 4);
+
+    DISTRHO_ASSERT_EQUAL(rb.acquireRead(rdata), 2, "contiguous read region after wrap");
+    DISTRHO_ASSERT_EQUAL(rdata[0], 0xaa, "wrapped read data matches");
+    DISTRHO_ASSERT_EQUAL(rdata[1], 0xbb, "wrapped read data matches");
+    rb.releaseRead(2);
+
+    DISTRHO_ASSERT_EQUAL(rb.isDataAvailableForReading(), false, "empty after zero-copy read");
+
+    return 0;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+int main()
+{
+    HeapRingBuffer heap;
+    DISTRHO_ASSERT_EQUAL(heap.createBuffer(256), true, "heap buffer creation");
+
+    if (testRingBuffer(heap) != 0)
+        return 1;
+
+    PaddedHeapRingBuffer padded;
+    DISTRHO_ASSERT_EQUAL(padded.createBuffer(256), true, "padded buffer creation");
+
+    if (testRingBuffer(padded) != 0)
+        return 1;
+
+    SmallStackRingBuffer stack;
+
+    if (testRingBuffer(stack) != 0)
+        return 1;
+
+    return 0;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,145 @@
+/*
+ * DISTRHO Plugin Framework (DPF)
+ * Copyright (C) 2012-2023 Filipe Coelho <falktx@falktx.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any purpose with
+ * or without fee is hereby granted, provided that the above copyright notice and this
+ * permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+ * TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+ * NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+ * IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "tests.hpp"
+
+#include "extra/RingBuffer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+// --------------------------------------------------------------------------------------------------------------------
+
+// 512 frames of stereo audio per block, 64MiB in total
+static const uint32_t kBlockSize = 512 * 2 * sizeof(float);
+static const uint32_t kNumBlocks = 64 * 1024 * 1024 / kBlockSize;
+static const uint32_t kBufferSize = kBlockSize * 8;
+
+// copy-based writes and reads, one block at a time
+template <class RingBuffer>
+static double benchmarkCopy(RingBuffer& rb)
+{
+    static uint8_t wblock[kBlockSize];
+    static uint8_t rblock[kBlockSize];
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::thread reader([&rb]() {
+        for (uint32_t i=0; i<kNumBlocks;)
+        {
+            if (rb.getReadableDataSize() < kBlockSize)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            rb.readCustomData(rblock, kBlockSize);
+            ++i;
+        }
+    });
+
+    for (uint32_t i=0; i<kNumBlocks;)
+    {
+        if (rb.getWritableDataSize() < kBlockSize)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        wblock[0] = static_cast<uint8_t>(i);
+        rb.writeCustomData(wblock, kBlockSize);
+        rb.commitWrite();
+        ++i;
+    }
+
+    reader.join();
+
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// zero-copy writes and reads, data is produced and consumed in place
+template <class RingBuffer>
+static double benchmarkZeroCopy(RingBuffer& rb)
+{
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::thread reader([&rb]() {
+        uint32_t sum = 0;
+
+        for (uint32_t remaining = kNumBlocks * kBlockSize; remaining != 0;)
+        {
+            const uint8_t* data;
+            const uint32_t size = std::min(rb.acquireRead(data), remaining);
+
+            if (size == 0)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            sum += data[0];
+            rb.releaseRead(size);
+            remaining -= size;
+        }
+
+        d_stdout("(checksum %u)", sum);
+    });
+
+    for (uint32_t remaining = kNumBlocks * kBlockSize; remaining != 0;)
+    {
+        uint8_t* data;
+        const uint32_t size = std::min(std::min(rb.acquireWrite(data), kBlockSize), remaining);
+
+        if (size == 0)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        data[0] = static_cast<uint8_t>(remaining);
+        rb.releaseWrite(size);
+        rb.commitWrite();
+        remaining -= size;
+    }
+
+    reader.join();
+
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+int main()
+{
+    const double mib = static_cast<double>(kNumBlocks) * kBlockSize / (1024.0 * 1024.0);
+
+    HeapRingBuffer heap;
+    heap.createBuffer(kBufferSize);
+
+    PaddedHeapRingBuffer padded;
+    padded.createBuffer(kBufferSize);
+
+    d_stdout("RingBuffer, %u byte blocks through a %u byte buffer between 2 threads:", kBlockSize, kBufferSize);
+    d_stdout("HeapRingBuffer       copy      %8.1f MiB/s", mib / benchmarkCopy(heap));
+    d_stdout("PaddedHeapRingBuffer copy      %8.1f MiB/s", mib / benchmarkCopy(padded));
+    d_stdout("HeapRingBuffer       zero-copy %8.1f MiB/s", mib / benchmarkZeroCopy(heap));
+    d_stdout("PaddedHeapRingBuffer zero-copy %8.1f MiB/s", mib / benchmarkZeroCopy(padded));
+
+    return 0;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
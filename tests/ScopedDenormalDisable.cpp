@@ -0,0 +1,51 @@
+/*
+ * DISTRHO Plugin Framework (DPF)
+ * Copyright (C) 2012-2023 Filipe Coelho <falktx@falktx.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any purpose with
+ * or without fee is hereby granted, provided that the above copyright notice and this
+ * permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+ * TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+ * NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+ * IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "tests.hpp"
+
+#include "extra/ScopedDenormalDisable.hpp"
+
+// --------------------------------------------------------------------------------------------------------------------
+
+// volatile so the compiler cannot fold the multiplications below
+static volatile float sTiny = 1e-30f;
+static volatile float sScale = 1e-10f;
+
+int main()
+{
+   #if defined(__SSE2_MATH__) || defined(__aarch64__) || (defined(__arm__) && !defined(__SOFTFP__))
+    DISTRHO_ASSERT_NOT_EQUAL(sTiny * sScale, 0.f, "denormal result by default");
+
+    {
+        const ScopedDenormalDisable sdd;
+        DISTRHO_ASSERT_EQUAL(sTiny * sScale, 0.f, "denormal result flushed to zero");
+
+        // nested use keeps the flags as they are
+        {
+            const ScopedDenormalDisable sdd2;
+            DISTRHO_ASSERT_EQUAL(sTiny * sScale, 0.f, "nested scope flushes to zero");
+        }
+
+        DISTRHO_ASSERT_EQUAL(sTiny * sScale, 0.f, "flags kept after nested scope");
+    }
+
+    DISTRHO_ASSERT_NOT_EQUAL(sTiny * sScale, 0.f, "flags restored after scope");
+   #endif
+
+    return 0;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
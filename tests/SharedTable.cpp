@@ -0,0 +1,153 @@
+/*
+ * DISTRHO Plugin Framework (DPF)
+ * Copyright (C) 2012-2023 Filipe Coelho <falktx@falktx.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any purpose with
+ * or without fee is hereby granted, provided that the above copyright notice and this
+ * permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+ * TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+ * NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+ * IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "tests.hpp"
+
+#include "extra/SharedTable.hpp"
+
+// --------------------------------------------------------------------------------------------------------------------
+
+static uint32_t sBuildCount = 0;
+
+struct RampTableBuilder {
+    typedef float ValueType;
+
+    static uint32_t getSize(const double sampleRate)
+    {
+        return static_cast<uint32_t>(sampleRate / 100.0);
+    }
+
+    static void build(const double sampleRate, float* const table, const uint32_t size)
+    {
+        ++sBuildCount;
+
+        for (uint32_t i=0; i<size; ++i)
+            table[i] = static_cast<float>(i / sampleRate);
+    }
+};
+
+typedef SharedTable<double, RampTableBuilder> RampTable;
+
+// same table layout, but a newer build() output
+struct RampTableBuilderV2 : RampTableBuilder {
+    static const uint32_t version = 2;
+};
+
+typedef SharedTable<double, RampTableBuilderV2> RampTableV2;
+
+// --------------------------------------------------------------------------------------------------------------------
+
+int main()
+{
+    // tables are shared between handles using the same key
+    {
+        RampTable table1, table2, table3;
+
+        DISTRHO_ASSERT_EQUAL(table1.isValid(), false, "invalid before acquire");
+        DISTRHO_ASSERT_EQUAL(table1.getData(), static_cast<const float*>(nullptr), "no data before acquire");
+
+        DISTRHO_ASSERT_EQUAL(table1.acquire(48000.0), true, "acquire");
+        DISTRHO_ASSERT_EQUAL(table2.acquire(48000.0), true, "acquire same key");
+        DISTRHO_ASSERT_EQUAL(sBuildCount, 1, "table built once");
+        DISTRHO_ASSERT_EQUAL(table1.getData(), table2.getData(), "same key shares data");
+        DISTRHO_ASSERT_EQUAL(table1.getSize(), 480, "table size");
+        DISTRHO_ASSERT_SAFE_EQUAL(table1.getData()[480 - 1], static_cast<float>(479 / 48000.0), "table contents");
+
+        DISTRHO_ASSERT_EQUAL(table3.acquire(44100.0), true, "acquire other key");
+        DISTRHO_ASSERT_EQUAL(sBuildCount, 2, "other key built separately");
+        DISTRHO_ASSERT_NOT_EQUAL(table1.getData(), table3.getData(), "other key has its own data");
+
+        // switching key releases the previous table
+        DISTRHO_ASSERT_EQUAL(table3.acquire(48000.0), true, "switch key");
+        DISTRHO_ASSERT_EQUAL(sBuildCount, 2, "switching to existing key does not build");
+        DISTRHO_ASSERT_EQUAL(table3.getData(), table1.getData(), "switched key shares data");
+
+        table1.release();
+        table2.release();
+        DISTRHO_ASSERT_EQUAL(table3.getSize(), 480, "table kept while still in use");
+    }
+
+    // tables are destroyed with the last handle
+    {
+        RampTable table;
+        DISTRHO_ASSERT_EQUAL(table.acquire(48000.0), true, "acquire after release");
+        DISTRHO_ASSERT_EQUAL(sBuildCount, 3, "table built again after last release");
+    }
+
+    // cache files
+   #ifndef DISTRHO_OS_WINDOWS
+    {
+        char filename[64];
+        std::snprintf(filename, sizeof(filename), "/tmp/dpf-shared-table-test-%d.bin", static_cast<int>(getpid()));
+        std::remove(filename);
+
+        {
+            RampTable table;
+            DISTRHO_ASSERT_EQUAL(table.acquire(96000.0, filename), true, "acquire with new cache file");
+            DISTRHO_ASSERT_EQUAL(sBuildCount, 4, "table built without cache file");
+            DISTRHO_ASSERT_EQUAL(table.isMapped(), false, "table built in memory");
+        }
+
+        {
+            RampTable table1, table2;
+            DISTRHO_ASSERT_EQUAL(table1.acquire(96000.0, filename), true, "acquire with existing cache file");
+            DISTRHO_ASSERT_EQUAL(table2.acquire(96000.0, filename), true, "acquire mapped table again");
+            DISTRHO_ASSERT_EQUAL(sBuildCount, 4, "table loaded from cache file");
+            DISTRHO_ASSERT_EQUAL(table1.isMapped(), true, "table mapped from cache file");
+            DISTRHO_ASSERT_EQUAL(table1.getData(), table2.getData(), "mapped table is shared");
+            DISTRHO_ASSERT_SAFE_EQUAL(table1.getData()[959], static_cast<float>(959 / 96000.0), "cached contents");
+        }
+
+        // a cache file with a different size is ignored
+        {
+            RampTable table;
+            DISTRHO_ASSERT_EQUAL(table.acquire(48000.0, filename), true, "acquire with mismatched cache file");
+            DISTRHO_ASSERT_EQUAL(sBuildCount, 5, "mismatched cache file is rebuilt");
+            DISTRHO_ASSERT_SAFE_EQUAL(table.getData()[479], static_cast<float>(479 / 48000.0), "rebuilt contents");
+        }
+
+        // a cache file with the same size but written for a different key is ignored
+        {
+            RampTable table;
+            DISTRHO_ASSERT_EQUAL(table.acquire(48000.5, filename), true, "acquire with cache file of other key");
+            DISTRHO_ASSERT_EQUAL(sBuildCount, 6, "cache file of other key is rebuilt");
+            DISTRHO_ASSERT_EQUAL(table.getSize(), 480, "other key has the same size");
+            DISTRHO_ASSERT_SAFE_EQUAL(table.getData()[479], static_cast<float>(479 / 48000.5), "other key contents");
+        }
+
+        // a cache file written by another builder version is ignored
+        {
+            RampTableV2 table;
+            DISTRHO_ASSERT_EQUAL(table.acquire(48000.5, filename), true, "acquire with cache file of old version");
+            DISTRHO_ASSERT_EQUAL(sBuildCount, 7, "cache file of old version is rebuilt");
+            DISTRHO_ASSERT_EQUAL(table.isMapped(), false, "old version is not mapped");
+        }
+
+        {
+            RampTableV2 table;
+            DISTRHO_ASSERT_EQUAL(table.acquire(48000.5, filename), true, "acquire with cache file of same version");
+            DISTRHO_ASSERT_EQUAL(sBuildCount, 7, "cache file of same version is used");
+            DISTRHO_ASSERT_EQUAL(table.isMapped(), true, "same version is mapped");
+        }
+
+        std::remove(filename);
+    }
+   #endif
+
+    return 0;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,282 @@
+/*
+ * DISTRHO Plugin Framework (DPF)
+ * Copyright (C) 2012-2023 Filipe Coelho <falktx@falktx.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any purpose with
+ * or without fee is hereby granted, provided that the above copyright notice and this
+ * permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+ * TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+ * NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+ * IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "tests.hpp"
+
+#include "extra/ValueSmoother.hpp"
+
+// --------------------------------------------------------------------------------------------------------------------
+
+// odd block sizes, so the 4-lane exponential loop also runs its leftovers
+static const uint32_t kBlockSizes[] = { 13, 64, 7 };
+static const uint32_t kTotalFrames = 13 + 64 + 7;
+
+// processBlock() uses a closed form, while next() accumulates rounding errors sample by sample
+static bool isClose(const float a, const float b)
+{
+    return std::abs(a - b) <= 1e-5f * (std::abs(b) > 1.f ? std::abs(b) : 1.f);
+}
+
+template <class Smoother>
+static void processInBlocks(Smoother& smoother, float* const out)
+{
+    for (uint32_t b = 0, offset = 0; b < ARRAY_SIZE(kBlockSizes); offset += kBlockSizes[b++])
+        smoother.processBlock(out + offset, kBlockSizes[b]);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+static int testExponential()
+{
+    ExponentialValueSmoother ref, smoother;
+    ref.setSampleRate(48000.f);
+    ref.setTimeConstant(0.01f);
+    ref.setTargetValue(1.f);
+    smoother = ref;
+
+    float expected[kTotalFrames];
+    float out[kTotalFrames];
+
+    for (uint32_t i=0; i<kTotalFrames; ++i)
+        expected[i] = ref.next();
+
+    // ramp endpoints: first sample is one step away from the start, block end leaves the state at the last value
+    const float first = smoother.peek();
+    smoother.processBlock(out, kTotalFrames);
+    DISTRHO_ASSERT_EQUAL(isClose(out[0], first), true, "exponential first sample");
+    DISTRHO_ASSERT_EQUAL((out[0] > 0.f && out[kTotalFrames - 1] < 1.f), true, "exponential ramp within range");
+    DISTRHO_ASSERT_SAFE_EQUAL(smoother.getCurrentValue(), out[kTotalFrames - 1], "exponential state after block");
+
+    for (uint32_t i=0; i<kTotalFrames; ++i)
+    {
+        DISTRHO_ASSERT_EQUAL(isClose(out[i], expected[i]), true, "exponential block matches next()");
+    }
+
+    // block boundaries do not show up in the output
+    smoother.setTargetValue(0.f);
+    smoother.clearToTargetValue();
+    smoother.setTargetValue(1.f);
+    processInBlocks(smoother, out);
+
+    for (uint32_t i=0; i<kTotalFrames; ++i)
+    {
+        DISTRHO_ASSERT_EQUAL(isClose(out[i], expected[i]), true, "exponential blocks match next()");
+    }
+
+    // gain ramp is the same curve applied as multiplier
+    smoother.setTargetValue(0.f);
+    smoother.clearToTargetValue();
+    smoother.setTargetValue(1.f);
+
+    for (uint32_t i=0; i<kTotalFrames; ++i)
+        out[i] = 0.5f;
+
+    smoother.applyGain(out, kTotalFrames);
+
+    for (uint32_t i=0; i<kTotalFrames; ++i)
+    {
+        DISTRHO_ASSERT_EQUAL(isClose(out[i], expected[i] * 0.5f), true, "exponential gain ramp");
+    }
+
+    // the curve eventually lands on the target exactly, from then on it is a constant fill
+    for (uint32_t i=0; i<48000; i += kTotalFrames)
+        smoother.processBlock(out, kTotalFrames);
+
+    smoother.processBlock(out, kTotalFrames);
+    DISTRHO_ASSERT_SAFE_EQUAL(smoother.getCurrentValue(), 1.f, "exponential snaps to target");
+
+    for (uint32_t i=0; i<kTotalFrames; ++i)
+    {
+        DISTRHO_ASSERT_SAFE_EQUAL(out[i], 1.f, "exponential constant fill");
+    }
+
+    return 0;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+static int testLinear()
+{
+    // 10 samples from 0 to 1
+    LinearValueSmoother ref, smoother;
+    ref.setSampleRate(1000.f);
+    ref.setTimeConstant(0.01f);
+    ref.setTargetValue(1.f);
+    smoother = ref;
+
+    float expected[kTotalFrames];
+    float out[kTotalFrames];
+
+    for (uint32_t i=0; i<kTotalFrames; ++i)
+        expected[i] = ref.next();
+
+    // ramp endpoints
+    smoother.processBlock(out, kTotalFrames);
+    DISTRHO_ASSERT_EQUAL(isClose(out[0], 0.1f), true, "linear first sample");
+    DISTRHO_ASSERT_EQUAL(isClose(out[9], 1.f), true, "linear last ramp sample");
+    DISTRHO_ASSERT_SAFE_EQUAL(smoother.getCurrentValue(), 1.f, "linear state after block");
+
+    for (uint32_t i=0; i<kTotalFrames; ++i)
+    {
+        DISTRHO_ASSERT_EQUAL(isClose(out[i], expected[i]), true, "linear block matches next()");
+    }
+
+    // the ramp ends on the target exactly and stays there
+    for (uint32_t i=10; i<kTotalFrames; ++i)
+    {
+        DISTRHO_ASSERT_SAFE_EQUAL(out[i], 1.f, "linear snaps to target");
+    }
+
+    // block boundaries do not show up in the output, a ramp crossing one keeps going
+    LinearValueSmoother slow;
+    slow.setSampleRate(1000.f);
+    slow.setTimeConstant(0.05f);
+    slow.setTargetValue(-2.f);
+    ref = slow;
+
+    for (uint32_t i=0; i<kTotalFrames; ++i)
+        expected[i] = ref.next();
+
+    processInBlocks(slow, out);
+
+    for (uint32_t i=0; i<kTotalFrames; ++i)
+    {
+        DISTRHO_ASSERT_EQUAL(isClose(out[i], expected[i]), true, "linear blocks match next()");
+    }
+
+    DISTRHO_ASSERT_SAFE_EQUAL(slow.getCurrentValue(), -2.f, "linear state after blocks");
+
+    // gain ramp is the same segment applied as multiplier
+    smoother.setTargetValue(0.f);
+    smoother.clearToTargetValue();
+    smoother.setTargetValue(1.f);
+
+    for (uint32_t i=0; i<kTotalFrames; ++i)
+        out[i] = 0.5f;
+
+    smoother.applyGain(out, 16);
+
+    for (uint32_t i=0; i<16; ++i)
+    {
+        const float gain = i < 10 ? 0.1f * static_cast<float>(i + 1) : 1.f;
+        DISTRHO_ASSERT_EQUAL(isClose(out[i], gain * 0.5f), true, "linear gain ramp");
+    }
+
+    // a segment shorter than a sample jumps to the target right away
+    LinearValueSmoother fast;
+    fast.setSampleRate(1000.f);
+    fast.setTimeConstant(0.0001f);
+    fast.setTargetValue(0.75f);
+    fast.processBlock(out, 4);
+
+    for (uint32_t i=0; i<4; ++i)
+    {
+        DISTRHO_ASSERT_SAFE_EQUAL(out[i], 0.75f, "linear jump to target");
+    }
+
+    return 0;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+static int testBank()
+{
+    static const float kTargets[3] = { 1.f, -0.5f, 0.25f };
+
+    SmootherBank<3> bank;
+    ExponentialValueSmoother refs[3];
+
+    bank.setSampleRate(48000.f);
+    bank.setTimeConstant(0.01f);
+
+    for (uint32_t k=0; k<3; ++k)
+    {
+        refs[k].setSampleRate(48000.f);
+        refs[k].setTimeConstant(0.01f);
+        refs[k].setTargetValue(kTargets[k]);
+        bank.setTargetValue(k, kTargets[k]);
+    }
+
+    DISTRHO_ASSERT_EQUAL(bank.isSettled(), false, "bank not settled with new targets");
+
+    float outs[3][kTotalFrames];
+    float* const outputs[3] = { outs[0], outs[1], outs[2] };
+
+    // every lane behaves like a separate exponential smoother, ending on the state of the last value
+    bank.processBlock(outputs, kTotalFrames);
+
+    for (uint32_t k=0; k<3; ++k)
+    {
+        for (uint32_t i=0; i<kTotalFrames; ++i)
+        {
+            DISTRHO_ASSERT_EQUAL(isClose(outs[k][i], refs[k].next()), true, "bank lane matches smoother");
+        }
+
+        DISTRHO_ASSERT_SAFE_EQUAL(bank.getCurrentValue(k), outs[k][kTotalFrames - 1], "bank state after block");
+    }
+
+    // block boundaries do not show up in the output
+    float blockOuts[3][kTotalFrames];
+
+    for (uint32_t k=0; k<3; ++k)
+        bank.setTargetValue(k, 0.f);
+    bank.clearToTargetValues();
+    for (uint32_t k=0; k<3; ++k)
+        bank.setTargetValue(k, kTargets[k]);
+
+    for (uint32_t b = 0, offset = 0; b < ARRAY_SIZE(kBlockSizes); offset += kBlockSizes[b++])
+    {
+        float* const blockOutputs[3] = { blockOuts[0] + offset, blockOuts[1] + offset, blockOuts[2] + offset };
+        bank.processBlock(blockOutputs, kBlockSizes[b]);
+    }
+
+    DISTRHO_ASSERT_EQUAL(std::memcmp(blockOuts, outs, sizeof(outs)), 0, "bank blocks match single block");
+
+    // all lanes eventually land on their targets exactly, from then on it is a constant fill
+    for (uint32_t i=0; i<48000; i += kTotalFrames)
+        bank.processBlock(outputs, kTotalFrames);
+
+    DISTRHO_ASSERT_EQUAL(bank.isSettled(), true, "bank settled");
+    bank.processBlock(outputs, kTotalFrames);
+
+    for (uint32_t k=0; k<3; ++k)
+    {
+        DISTRHO_ASSERT_SAFE_EQUAL(bank.getCurrentValue(k), kTargets[k], "bank snaps to target");
+
+        for (uint32_t i=0; i<kTotalFrames; ++i)
+        {
+            DISTRHO_ASSERT_SAFE_EQUAL(outs[k][i], kTargets[k], "bank constant fill");
+        }
+    }
+
+    return 0;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+int main()
+{
+    if (const int ret = testExponential())
+        return ret;
+    if (const int ret = testLinear())
+        return ret;
+    if (const int ret = testBank())
+        return ret;
+
+    return 0;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
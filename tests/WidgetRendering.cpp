@@ -0,0 +1,131 @@
+/*
+ * DISTRHO Plugin Framework (DPF)
+ * Copyright (C) 2012-2023 Filipe Coelho <falktx@falktx.com>
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any purpose with
+ * or without fee is hereby granted, provided that the above copyright notice and this
+ * permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+ * TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+ * NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+ * IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+// this test is linked against the headless DGL build, see USE_HEADLESS in Makefile.base.mk
+
+#include "tests.hpp"
+
+#include "dgl/Application.hpp"
+#include "dgl/Color.hpp"
+#include "dgl/TopLevelWidget.hpp"
+#include "dgl/Window.hpp"
+
+#include <cstring>
+
+// --------------------------------------------------------------------------------------------------------------------
+
+// left half red, right half blue
+class SplitColorWidget : public TopLevelWidget
+{
+public:
+    explicit SplitColorWidget(Window& window)
+        : TopLevelWidget(window) {}
+
+protected:
+    void onDisplay() override
+    {
+        const GraphicsContext& context(getGraphicsContext());
+        const int width = static_cast<int>(getWidth());
+        const int height = static_cast<int>(getHeight());
+
+        Color(255, 0, 0).setFor(context);
+        Rectangle<int>(0, 0, width / 2, height).draw(context);
+
+        Color(0, 0, 255).setFor(context);
+        Rectangle<int>(width / 2, 0, width - width / 2, height).draw(context);
+    }
+};
+
+class CapturingWindow : public Window
+{
+public:
+    uint8_t* pixels;
+    uint32_t pixelsWidth;
+    uint32_t pixelsHeight;
+
+    explicit CapturingWindow(Application& app)
+        : Window(app),
+          pixels(nullptr),
+          pixelsWidth(0),
+          pixelsHeight(0) {}
+
+    ~CapturingWindow() override
+    {
+        delete[] pixels;
+    }
+
+    bool capture(Application& app)
+    {
+        delete[] pixels;
+        pixels = nullptr;
+
+        captureFrame();
+
+        // capture might complete one frame later
+        for (int i = 0; i < 10 && pixels == nullptr; ++i)
+            app.idle();
+
+        return pixels != nullptr;
+    }
+
+    bool isPixel(const uint32_t x, const uint32_t y, const uint8_t r, const uint8_t g, const uint8_t b) const
+    {
+        const uint8_t* const pixel = pixels + (y * pixelsWidth + x) * 4;
+        return pixel[0] == r && pixel[1] == g && pixel[2] == b;
+    }
+
+protected:
+    void onFrameCaptured(const uint8_t* const data, const uint32_t width, const uint32_t height) override
+    {
+        pixels = new uint8_t[width * height * 4];
+        pixelsWidth = width;
+        pixelsHeight = height;
+        std::memcpy(pixels, data, width * height * 4);
+    }
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+
+int main()
+{
+    Application app(true);
+    CapturingWindow window(app);
+    SplitColorWidget widget(window);
+    window.setSize(64, 32);
+    window.show();
+
+    DISTRHO_ASSERT_EQUAL(window.capture(app), true, "frame captured");
+    DISTRHO_ASSERT_EQUAL(window.pixelsWidth, 64, "captured width");
+    DISTRHO_ASSERT_EQUAL(window.pixelsHeight, 32, "captured height");
+    DISTRHO_ASSERT_EQUAL(window.isPixel(0, 0, 255, 0, 0), true, "top-left is red");
+    DISTRHO_ASSERT_EQUAL(window.isPixel(31, 31, 255, 0, 0), true, "bottom of left half is red");
+    DISTRHO_ASSERT_EQUAL(window.isPixel(32, 0, 0, 0, 255), true, "top of right half is blue");
+    DISTRHO_ASSERT_EQUAL(window.isPixel(63, 31, 0, 0, 255), true, "bottom-right is blue");
+
+    // the offscreen surface follows the window size
+    window.setSize(100, 40);
+
+    DISTRHO_ASSERT_EQUAL(window.capture(app), true, "frame captured after resize");
+    DISTRHO_ASSERT_EQUAL(window.pixelsWidth, 100, "captured width after resize");
+    DISTRHO_ASSERT_EQUAL(window.pixelsHeight, 40, "captured height after resize");
+    DISTRHO_ASSERT_EQUAL(window.isPixel(49, 39, 255, 0, 0), true, "left half is red after resize");
+    DISTRHO_ASSERT_EQUAL(window.isPixel(50, 0, 0, 0, 255), true, "right half is blue after resize");
+
+    window.close();
+    return 0;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
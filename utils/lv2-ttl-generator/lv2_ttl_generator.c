@@ -67,14 +67,21 @@ int main(int argc, char* argv[])
 #  pragma GCC diagnostic push
 #  pragma GCC diagnostic ignored "-Wcast-function-type"
 # endif
-    const TTL_Generator_Function ttlFn = (TTL_Generator_Function)GetProcAddress(handle, "lv2_generate_ttl");
+    TTL_Generator_Function ttlFn = (TTL_Generator_Function)GetProcAddress(handle, "lv2_generate_ttl");
+    const TTL_Generator_Function moduleInfoFn = (TTL_Generator_Function)GetProcAddress(handle, "vst3_generate_moduleinfo");
 # if defined(__GNUC__) && (__GNUC__ >= 9)
 #  pragma GCC diagnostic pop
 # endif
 #else
-    const TTL_Generator_Function ttlFn = (TTL_Generator_Function)dlsym(handle, "lv2_generate_ttl");
+    TTL_Generator_Function ttlFn = (TTL_Generator_Function)dlsym(handle, "lv2_generate_ttl");
+    const TTL_Generator_Function moduleInfoFn = (TTL_Generator_Function)dlsym(handle, "vst3_generate_moduleinfo");
 #endif
 
+    // VST3 binaries generate moduleinfo.json instead
+    const char* const what = ttlFn != NULL ? "ttl" : "moduleinfo.json";
+    if (ttlFn == NULL)
+        ttlFn = moduleInfoFn;
+
     if (ttlFn != NULL)
     {
         // convert the paths to a normalized form, such that path separators are
@@ -98,14 +105,14 @@ int main(int argc, char* argv[])
         if (dotPos)
             *dotPos = '\0';
 
-        printf("Generate ttl data for '%s', basename: '%s'\n", path, basename);
+        printf("Generate %s data for '%s', basename: '%s'\n", what, path, basename);
 
         ttlFn(basename);
 
         free(normalPath);
     }
     else
-        printf("Failed to find 'lv2_generate_ttl' function\n");
+        printf("Failed to find 'lv2_generate_ttl' or 'vst3_generate_moduleinfo' function\n");
 
 #ifdef TTL_GENERATOR_WINDOWS
     FreeLibrary(handle);
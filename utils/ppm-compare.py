@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+# DISTRHO Plugin Framework (DPF)
+# Copyright (C) 2012-2023 Filipe Coelho <falktx@falktx.com>
+#
+# Permission to use, copy, modify, and/or distribute this software for any purpose with
+# or without fee is hereby granted, provided that the above copyright notice and this
+# permission notice appear in all copies.
+#
+# THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+# TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+# NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+# DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+# IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+# CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+# Compares a picture written by Window::renderToPicture() against a golden (reference) one.
+# Exits with status 1 if the pictures differ, optionally writing the differing pixels into a new picture.
+
+import argparse, sys
+
+# -----------------------------------------------------
+
+def readppm(filename):
+    with open(filename, "rb") as fd:
+        data = fd.read()
+
+    # header is made of magic, width, height and maximum value, with optional comments
+    tokens = []
+    pos = 0
+    while len(tokens) < 4:
+        while data[pos:pos+1].isspace():
+            pos += 1
+        if data[pos:pos+1] == b"#":
+            while data[pos:pos+1] not in (b"\n", b""):
+                pos += 1
+            continue
+        start = pos
+        while pos < len(data) and not data[pos:pos+1].isspace():
+            pos += 1
+        tokens.append(data[start:pos])
+
+    magic = tokens[0]
+    width, height, maxval = int(tokens[1]), int(tokens[2]), int(tokens[3])
+
+    if maxval > 255:
+        raise ValueError("%s: 16-bit pictures are not supported" % filename)
+
+    if magic == b"P6":
+        pixels = list(data[pos+1:pos+1+width*height*3])
+    elif magic == b"P3":
+        pixels = [int(v) for v in data[pos:].split()]
+    else:
+        raise ValueError("%s: not a PPM picture" % filename)
+
+    if len(pixels) != width * height * 3:
+        raise ValueError("%s: truncated picture" % filename)
+
+    return width, height, pixels
+
+def writeppm(filename, width, height, pixels):
+    with open(filename, "wb") as fd:
+        fd.write(b"P6\n%d %d\n255\n" % (width, height))
+        fd.write(bytes(pixels))
+
+def ppmcompare(filename, golden, tolerance, maxdiff, diffname):
+    width, height, pixels = readppm(filename)
+    gwidth, gheight, gpixels = readppm(golden)
+
+    if (width, height) != (gwidth, gheight):
+        print("%s: size %dx%d does not match golden %dx%d" % (filename, width, height, gwidth, gheight))
+        return False
+
+    diffpixels = [0] * (width * height * 3)
+    numdiff = 0
+
+    for i in range(0, width * height * 3, 3):
+        if max(abs(pixels[i+c] - gpixels[i+c]) for c in range(3)) > tolerance:
+            numdiff += 1
+            diffpixels[i] = 255
+        else:
+            # keep a dimmed version of the golden picture around the differences
+            diffpixels[i:i+3] = [v // 4 for v in gpixels[i:i+3]]
+
+    ratio = numdiff / (width * height)
+    ok = ratio <= maxdiff
+
+    print("%s: %d of %d pixels differ (%.3f%%)%s" % (filename, numdiff, width * height, ratio * 100,
+                                                     "" if ok else ", over the %.3f%% limit" % (maxdiff * 100)))
+
+    if diffname and numdiff != 0:
+        writeppm(diffname, width, height, diffpixels)
+
+    return ok
+
+# -----------------------------------------------------
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description="Compare a rendered PPM picture against a golden one")
+    parser.add_argument("picture")
+    parser.add_argument("golden")
+    parser.add_argument("--tolerance", type=int, default=2,
+                        help="maximum difference per color channel for a pixel to be considered equal")
+    parser.add_argument("--max-diff", type=float, default=0.0,
+                        help="fraction of pixels allowed to differ")
+    parser.add_argument("--diff", help="write differing pixels (in red) into this file")
+    args = parser.parse_args()
+
+    sys.exit(0 if ppmcompare(args.picture, args.golden, args.tolerance, args.max_diff, args.diff) else 1)
+
+# -----------------------------------------------------